@@ -0,0 +1,250 @@
+// Platform headers first: windows.h defines APIENTRY unconditionally,
+// glad (pulled in through Chunk.h) only when it is not yet defined
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+#include "../include/Chunk.h"
+#include "../include/HeightTileCache.h"
+#include "../include/JobSystem.h"
+#include "../include/RegionCache.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define BAKE_TILE_CACHE_SIZE 1024       // As World: ~8 MB of heightmap tiles, shared by the workers
+#define BAKE_PROGRESS_INTERVAL_MS 1000  // How often progress is printed
+
+/* ------------------------- */
+/* Bake settings, from the command line */
+/* ------------------------- */
+struct BakeOptions
+{
+    int seed = DEFAULT_TERRAIN_SEED;
+    glm::ivec2 minChunk = glm::ivec2(0), maxChunk = glm::ivec2(-1);   // Inclusive
+    int threads = 0;                    // 0 = hardware concurrency
+    int lods = LOD_LEVELS;              // Bakes LOD 0 .. lods - 1
+    std::string directory = REGION_CACHE_DIR;
+    bool force = false;                 // Regenerate chunks already in the cache
+};
+
+static void printUsage()
+{
+    std::printf(
+        "Usage: TerrainBaker --rect x0 z0 x1 z1 [options]\n"
+        "Generates chunks x0..x1 by z0..z1 (inclusive, chunk coordinates) into region files\n"
+        "  --seed N       terrain seed (default %d, the game's)\n"
+        "  --threads N    worker threads (default: hardware concurrency)\n"
+        "  --lods N       bake LOD 0..N-1 (default %d, every level the game streams)\n"
+        "  --out DIR      region directory (default %s, where the game looks)\n"
+        "  --force        regenerate chunks the directory already holds\n",
+        DEFAULT_TERRAIN_SEED, LOD_LEVELS, REGION_CACHE_DIR);
+}
+
+// Parses one integer argument; false if it is missing or not a number
+static bool parseInt(int argc, char** argv, int& i, int& out)
+{
+    if (i + 1 >= argc)
+        return false;
+    char* end = nullptr;
+    long v = std::strtol(argv[++i], &end, 10);
+    out = int(v);
+    return *argv[i] != '\0' && *end == '\0';
+}
+
+static bool parseOptions(int argc, char** argv, BakeOptions& o)
+{
+    bool haveRect = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        bool ok = true;
+        if (std::strcmp(argv[i], "--rect") == 0)
+        {
+            ok = parseInt(argc, argv, i, o.minChunk.x) && parseInt(argc, argv, i, o.minChunk.y)
+                && parseInt(argc, argv, i, o.maxChunk.x) && parseInt(argc, argv, i, o.maxChunk.y);
+            haveRect = ok;
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0)
+            ok = parseInt(argc, argv, i, o.seed);
+        else if (std::strcmp(argv[i], "--threads") == 0)
+            ok = parseInt(argc, argv, i, o.threads) && o.threads >= 0;
+        else if (std::strcmp(argv[i], "--lods") == 0)
+            ok = parseInt(argc, argv, i, o.lods) && o.lods >= 1 && o.lods <= LOD_LEVELS;
+        else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+            o.directory = argv[++i];
+        else if (std::strcmp(argv[i], "--force") == 0)
+            o.force = true;
+        else
+            ok = false;
+
+        if (!ok)
+        {
+            std::fprintf(stderr, "TerrainBaker: bad argument near '%s'\n", argv[i]);
+            return false;
+        }
+    }
+
+    // Either corner order is accepted
+    glm::ivec2 lo = glm::min(o.minChunk, o.maxChunk), hi = glm::max(o.minChunk, o.maxChunk);
+    o.minChunk = lo;
+    o.maxChunk = hi;
+    return haveRect;
+}
+
+// Peak resident set size of this process in bytes (0 if unknown)
+static std::uint64_t peakResidentBytes()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return std::uint64_t(counters.PeakWorkingSetSize);
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#if defined(__APPLE__)
+    return std::uint64_t(usage.ru_maxrss);           // Bytes on macOS
+#else
+    return std::uint64_t(usage.ru_maxrss) * 1024;    // Kilobytes on Linux
+#endif
+#endif
+}
+
+/* ------------------------- */
+/* Chunks in region order: each region is finished before the next, so */
+/* the cache keeps few files open and neighbouring chunks share tiles */
+/* ------------------------- */
+static std::vector<glm::ivec2> bakeOrder(glm::ivec2 lo, glm::ivec2 hi)
+{
+    std::vector<glm::ivec2> order;
+    order.reserve(std::size_t(hi.x - lo.x + 1) * std::size_t(hi.y - lo.y + 1));
+
+    glm::ivec2 firstRegion = RegionCache::regionOf(lo), lastRegion = RegionCache::regionOf(hi);
+    for (int rx = firstRegion.x; rx <= lastRegion.x; ++rx)
+        for (int rz = firstRegion.y; rz <= lastRegion.y; ++rz)
+        {
+            glm::ivec2 from = glm::max(lo, glm::ivec2(rx, rz) * REGION_SIZE);
+            glm::ivec2 to = glm::min(hi, glm::ivec2(rx, rz) * REGION_SIZE + (REGION_SIZE - 1));
+            for (int x = from.x; x <= to.x; ++x)
+                for (int z = from.y; z <= to.y; ++z)
+                    order.push_back(glm::ivec2(x, z));
+        }
+    return order;
+}
+
+/* ------------------------- */
+/* Usage: TerrainBaker --rect x0 z0 x1 z1 [--seed N] [--threads N] */
+/* [--lods N] [--out DIR] [--force] */
+/* Headless: generates chunks with the game's pipeline (Chunk:: */
+/* generateData on JobSystem workers, one HeightTileCache) and stores */
+/* them in region files the game then loads instead of generating */
+/* ------------------------- */
+int main(int argc, char** argv)
+{
+    BakeOptions options;
+    if (!parseOptions(argc, argv, options))
+    {
+        printUsage();
+        return 1;
+    }
+
+    float voxelScale = float(VOXEL_SIZE) / DESIGN_VOXEL;
+    BiomeManager biome(voxelScale, WATER_LEVEL_WORLD, options.seed);
+    HeightTileCache tiles(&biome, BAKE_TILE_CACHE_SIZE);
+    RegionCache cache(options.directory, biome.generatorKey());
+    JobSystem jobs(options.threads);
+
+    std::vector<glm::ivec2> order = bakeOrder(options.minChunk, options.maxChunk);
+    std::printf("Baking %zu chunks (%d,%d)..(%d,%d), LOD 0..%d, seed %d, %d threads, into %s/\n",
+        order.size(), options.minChunk.x, options.minChunk.y, options.maxChunk.x, options.maxChunk.y,
+        options.lods - 1, options.seed, jobs.threadCount(), options.directory.c_str());
+
+    std::atomic<std::size_t> nextChunk{ 0 }, chunksDone{ 0 };
+    std::atomic<std::uint64_t> meshesBuilt{ 0 }, meshesSkipped{ 0 }, triangles{ 0 };
+
+    // One job per worker, each pulling chunks in bake order; a job per
+    // chunk would queue millions of closures for a large area
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < jobs.threadCount(); ++t)
+        jobs.submit([&]
+        {
+            std::vector<PackedVertex> vertices;
+            std::vector<unsigned int> indices;
+            for (std::size_t i = nextChunk++; i < order.size(); i = nextChunk++)
+            {
+                for (int lod = 0; lod < options.lods; ++lod)
+                {
+                    CachedMesh existing;
+                    if (!options.force && cache.load(order[i], lod, existing))
+                    {
+                        meshesSkipped.fetch_add(1, std::memory_order_relaxed);
+                        continue;
+                    }
+
+                    Chunk chunk(order[i], &biome, &tiles, lod);
+                    chunk.generateData(vertices, indices);
+                    cache.store(order[i], lod, chunk.meshInfo(), vertices, indices);
+                    meshesBuilt.fetch_add(1, std::memory_order_relaxed);
+                    triangles.fetch_add(indices.size() / 3, std::memory_order_relaxed);
+                }
+                chunksDone.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+
+    // Progress while the workers run; polled finely so the end is timed closely
+    auto lastReport = start;
+    while (chunksDone.load(std::memory_order_relaxed) < order.size())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastReport < std::chrono::milliseconds(BAKE_PROGRESS_INTERVAL_MS))
+            continue;
+
+        lastReport = now;
+        std::size_t done = chunksDone.load(std::memory_order_relaxed);
+        double seconds = std::chrono::duration<double>(now - start).count();
+        std::printf("  %zu/%zu chunks (%.1f%%), %.0f chunks/s\n",
+            done, order.size(), 100.0 * double(done) / double(order.size()), done / seconds);
+        std::fflush(stdout);
+    }
+    jobs.waitIdle();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    RegionCache::Stats stats = cache.stats();
+    JobSystem::Stats jobStats = jobs.stats();
+    std::uint64_t built = meshesBuilt.load(), skipped = meshesSkipped.load(), tris = triangles.load();
+
+    std::printf("Done in %.2f s\n", seconds);
+    std::printf("  chunks:    %zu (%.0f chunks/s, all LODs)\n", order.size(), order.size() / seconds);
+    std::printf("  meshes:    %llu generated, %llu already cached\n",
+        (unsigned long long)built, (unsigned long long)skipped);
+    std::printf("  triangles: %llu (%.2f M triangles/s)\n", (unsigned long long)tris, tris / seconds * 1e-6);
+    std::printf("  written:   %.1f MB (%.1f MB/s), %llu stale regions reset\n",
+        stats.bytesWritten / double(1 << 20), stats.bytesWritten / double(1 << 20) / seconds,
+        (unsigned long long)stats.staleRegions);
+    std::printf("  workers:   %.0f%% busy\n", 100.0 * jobStats.busySeconds / (seconds * jobs.threadCount()));
+    std::printf("  peak RSS:  %.1f MB\n", peakResidentBytes() / double(1 << 20));
+
+    // store() drops a record it cannot write; the area is then only partly baked
+    if (stats.stores != built)
+    {
+        std::fprintf(stderr, "TerrainBaker: %llu of %llu meshes could not be written to %s\n",
+            (unsigned long long)(built - stats.stores), (unsigned long long)built, options.directory.c_str());
+        return 2;
+    }
+    return 0;
+}
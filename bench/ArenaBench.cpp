@@ -0,0 +1,144 @@
+#include "Bench.h"
+#include "FakeArenaBackend.h"
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// A mesh whose contents identify it, so misplaced ranges are detected
+static void makeMesh(unsigned tag, std::size_t vertexCount, std::vector<PackedVertex>& v, std::vector<unsigned int>& idx)
+{
+    v.resize(vertexCount);
+    for (std::size_t i = 0; i < vertexCount; ++i)
+    {
+        v[i].position[0] = std::uint16_t(tag);
+        v[i].position[1] = std::uint16_t(i);
+        v[i].position[2] = std::uint16_t(tag >> 16);
+        v[i].normal[0] = v[i].normal[1] = 0;
+        v[i].color[0] = v[i].color[1] = v[i].color[2] = v[i].color[3] = std::uint8_t(tag);
+    }
+
+    idx.resize(vertexCount * 2 - vertexCount % 3);
+    for (std::size_t i = 0; i < idx.size(); ++i)
+        idx[i] = unsigned((i * 7 + tag) % vertexCount);
+}
+
+static glm::vec3 originFor(unsigned tag)
+{
+    return glm::vec3(float(tag) * 256.0f, 0.0f, -float(tag));
+}
+
+// Reads a mesh back through the arena's bound VAO and page table and compares it
+static bool verifyMesh(const FakeArenaBackend& gpu, const MeshArena::DrawRange& r, unsigned tag,
+    const std::vector<PackedVertex>& v, const std::vector<unsigned int>& idx)
+{
+    const auto& buffers = gpu.vertexArrays.at(gpu.boundVertexArray);
+    const std::vector<unsigned char>& vb = gpu.buffers.at(buffers.first);
+    const std::vector<unsigned char>& ib = gpu.buffers.at(buffers.second);
+
+    if (r.indexCount != idx.size())
+        return false;
+    if (std::memcmp(ib.data() + r.firstIndex * sizeof(unsigned int), idx.data(), idx.size() * sizeof(unsigned int)) != 0)
+        return false;
+    if (std::memcmp(vb.data() + std::size_t(r.baseVertex) * sizeof(PackedVertex), v.data(), v.size() * sizeof(PackedVertex)) != 0)
+        return false;
+
+    // Every page the mesh touches must carry its origin
+    for (std::size_t vertex = r.baseVertex; vertex < r.baseVertex + v.size(); vertex += MeshArena::PAGE_VERTICES)
+        if (gpu.pageOrigin(vertex / MeshArena::PAGE_VERTICES) != originFor(tag))
+            return false;
+    return true;
+}
+
+/* ------------------------- */
+/* MeshArena churn benchmark */
+/* Streams chunk-sized meshes in and out (like flying across the map), */
+/* verifying every live mesh against the fake GPU buffers as it goes, */
+/* and reports occupancy and fragmentation */
+/* ------------------------- */
+void benchMeshArena()
+{
+    FakeArenaBackend gpu;
+    MeshArena arena(&gpu, 1 << 16, 3 << 16);
+
+    struct Live
+    {
+        MeshHandle handle;
+        unsigned tag;
+        std::vector<PackedVertex> v;
+        std::vector<unsigned int> idx;
+    };
+    std::vector<Live> live;
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> size(200, 3000);   // Vertices per chunk mesh
+    const int steps = 20000;
+    const std::size_t target = 300;                       // Roughly a radius-8 load window
+    unsigned tag = 0;
+    int failures = 0;
+    double worstVertexFrag = 0.0, worstIndexFrag = 0.0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int step = 0; step < steps; ++step)
+    {
+        // Unload a random mesh once the window is full, then load a new one
+        if (live.size() >= target)
+        {
+            std::size_t victim = rng() % live.size();
+            arena.release(live[victim].handle);
+            live[victim] = std::move(live.back());
+            live.pop_back();
+        }
+
+        Live mesh;
+        mesh.tag = ++tag;
+        makeMesh(mesh.tag, std::size_t(size(rng)), mesh.v, mesh.idx);
+        mesh.handle = arena.allocate(mesh.v, mesh.idx, originFor(mesh.tag));
+        live.push_back(std::move(mesh));
+
+        MeshArena::Stats s = arena.stats();
+        worstVertexFrag = std::max(worstVertexFrag, s.vertexFragmentation);
+        worstIndexFrag = std::max(worstIndexFrag, s.indexFragmentation);
+
+        // Full content check every so often (and at the end)
+        if (step % 1000 == 999)
+        {
+            arena.bind();
+            for (const Live& m : live)
+                if (!verifyMesh(gpu, arena.range(m.handle), m.tag, m.v, m.idx))
+                    ++failures;
+        }
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / steps;
+
+    char extra[96];
+    std::snprintf(extra, sizeof(extra), "%d mismatches, %s", failures, gpu.outOfBounds ? "OUT OF BOUNDS" : "in bounds");
+    reportRow("release + allocate + upload (fake GPU)", ns, extra);
+    benchCheck(failures == 0, "arena meshes differ from what was uploaded");
+    benchCheck(!gpu.outOfBounds, "arena wrote or drew outside its buffers");
+
+    MeshArena::Stats s = arena.stats();
+    std::printf("  live meshes %zu, GL buffers alive %zu, vertex arrays alive %zu\n",
+        s.liveMeshes, gpu.buffers.size(), gpu.vertexArrays.size());
+    std::printf("  vertices %zu / %zu (%.1f%%), %zu free blocks, fragmentation %.3f (worst %.3f)\n",
+        s.vertexUsed, s.vertexCapacity, 100.0 * s.vertexUsed / s.vertexCapacity, s.vertexFreeBlocks,
+        s.vertexFragmentation, worstVertexFrag);
+    std::printf("  indices  %zu / %zu (%.1f%%), %zu free blocks, fragmentation %.3f (worst %.3f)\n",
+        s.indexUsed, s.indexCapacity, 100.0 * s.indexUsed / s.indexCapacity, s.indexFreeBlocks,
+        s.indexFragmentation, worstIndexFrag);
+    std::printf("  %llu grows, %llu compactions, %.1f MB moved on the GPU\n",
+        (unsigned long long)s.grows, (unsigned long long)s.defragments, s.bytesMoved / (1024.0 * 1024.0));
+
+    // Explicit compaction leaves one free block per buffer and intact contents
+    arena.defragment();
+    arena.bind();
+    int afterDefrag = 0;
+    for (const Live& m : live)
+        if (!verifyMesh(gpu, arena.range(m.handle), m.tag, m.v, m.idx))
+            ++afterDefrag;
+    s = arena.stats();
+    std::printf("  after defragment(): %zu + %zu free blocks, %d mismatches\n",
+        s.vertexFreeBlocks, s.indexFreeBlocks, afterDefrag);
+    benchCheck(afterDefrag == 0, "defragment() corrupted mesh contents");
+    benchCheck(s.vertexFreeBlocks <= 1 && s.indexFreeBlocks <= 1, "defragment() left more than one free block per buffer");
+}
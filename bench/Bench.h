@@ -0,0 +1,37 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+
+/* ------------------------- */
+/* Minimal timing helpers shared by all benchmarks */
+/* ------------------------- */
+
+// Written by benchmarks so the optimiser cannot discard their results
+extern volatile double benchSink;
+
+// Records a correctness check; a failed one is printed as "FAILED: what"
+// and makes TerrainBench exit non-zero. Returns passed
+bool benchCheck(bool passed, const char* what);
+
+// Value of a "--name=value" command-line option, or fallback if it was not given
+const char* benchOption(const char* name, const char* fallback);
+
+// Runs fn once to warm up, then returns the mean nanoseconds per call
+template <typename F>
+double nsPerOp(F&& fn, int iterations)
+{
+    fn();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        fn();
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+// Prints one result row: name, ns/op and an optional extra column
+inline void reportRow(const char* name, double ns, const char* extra = "")
+{
+    std::printf("  %-40s %14.1f ns/op  %s\n", name, ns, extra);
+}
@@ -0,0 +1,96 @@
+#include "Bench.h"
+#include "../include/Chunk.h"
+#include "../include/FrustumCuller.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+/* ------------------------- */
+/* Frustum culling benchmark */
+/* A square of chunk boxes with terrain-like tight Y bounds, culled for */
+/* a camera above the centre: the old per-chunk test (planes extracted */
+/* per box, full-height boxes) against FrustumCuller at each SIMD level */
+/* ------------------------- */
+static void runCull(std::size_t target)
+{
+    const float chunkWorld = float(CHUNK_SIZE * VOXEL_SIZE);
+    const float fullHeight = float(CHUNK_HEIGHT * VOXEL_SIZE);
+    int side = int(std::sqrt(double(target)));
+    int half = side / 2;
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> ground(0.35f * fullHeight, 0.55f * fullHeight);
+    std::uniform_real_distribution<float> relief(4.0f, 40.0f);
+
+    FrustumCuller tight, full;
+    std::vector<glm::ivec2> positions;
+    for (int z = 0; z < side; ++z)
+    {
+        for (int x = 0; x < side; ++x)
+        {
+            glm::vec3 lo(float(x - half) * chunkWorld, ground(rng), float(z - half) * chunkWorld);
+            glm::vec3 hi(lo.x + chunkWorld, lo.y + relief(rng), lo.z + chunkWorld);
+            std::uint32_t id = std::uint32_t(positions.size());
+            tight.set(id, lo, hi);
+            full.set(id, glm::vec3(lo.x, 0.0f, lo.z), glm::vec3(hi.x, fullHeight, hi.z));
+            positions.push_back(glm::ivec2(x - half, z - half));
+        }
+    }
+    std::size_t count = positions.size();
+
+    // Looking slightly down over the terrain, so tight Y bounds matter
+    glm::vec3 eye(0.0f, 0.6f * fullHeight, 0.0f);
+    glm::mat4 proj = glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 1e6f);
+    glm::mat4 viewProj = proj * glm::lookAt(eye, eye + glm::vec3(1.0f, -0.35f, 0.4f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+    const int iterations = count > 50000 ? 50 : 500;
+    char name[64], extra[128];
+
+    // Old path: a Frustum per chunk from the view-projection matrix, full-height box
+    std::size_t oldVisible = 0;
+    double ns = nsPerOp([&]
+        {
+            oldVisible = 0;
+            for (const glm::ivec2& pos : positions)
+            {
+                glm::vec3 lo(pos.x * chunkWorld, 0.0f, pos.y * chunkWorld);
+                oldVisible += Frustum(viewProj).intersects(lo, lo + glm::vec3(chunkWorld, fullHeight, chunkWorld));
+            }
+            benchSink = benchSink + double(oldVisible);
+        }, iterations);
+    std::snprintf(name, sizeof(name), "%zu chunks, per-chunk planes", count);
+    std::snprintf(extra, sizeof(extra), "%.2f ns/chunk, %zu visible (full height)", ns / count, oldVisible);
+    reportRow(name, ns, extra);
+
+    std::vector<std::uint32_t> reference, visible;
+    tight.cullLevel(SimdLevel::Scalar, Frustum(viewProj), reference);
+
+    SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::SSE41, SimdLevel::AVX2 };
+    for (SimdLevel level : levels)
+    {
+        if (int(level) > int(detectSimdLevel()))
+            continue;
+
+        ns = nsPerOp([&]
+            {
+                tight.cullLevel(level, Frustum(viewProj), visible);
+                benchSink = benchSink + double(visible.size());
+            }, iterations);
+        std::snprintf(name, sizeof(name), "%zu chunks, batch %s", count, level == SimdLevel::Scalar ? "scalar" :
+            level == SimdLevel::SSE41 ? "SSE" : "AVX");
+        std::snprintf(extra, sizeof(extra), "%.2f ns/chunk, %zu visible, %s", ns / count, visible.size(),
+            visible == reference ? "matches scalar" : "MISMATCH");
+        reportRow(name, ns, extra);
+    }
+
+    full.cull(Frustum(viewProj), visible);
+    std::printf("  tight Y bounds: %zu visible vs %zu with full-height boxes (%s old test)\n",
+        reference.size(), visible.size(), visible.size() == oldVisible ? "same as" : "DIFFERS from");
+}
+
+void benchFrustumCull()
+{
+    runCull(10000);
+    runCull(100000);
+}
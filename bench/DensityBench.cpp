@@ -0,0 +1,135 @@
+#include "Bench.h"
+#include "../include/Chunk.h"
+#include "../include/DensityGrid.h"
+#include "../include/Voxel.h"
+#include <vector>
+
+/* ------------------------- */
+/* Density storage benchmark */
+/* Runs the corner gather + cube classification of the meshing loop */
+/* over the old triple-nested vector and over DensityGrid layouts */
+/* ------------------------- */
+
+using NestedField = std::vector<std::vector<std::vector<float>>>;
+
+static const int CORNER[8][3] = {
+    {0, 0, 0}, {1, 0, 0}, {1, 0, 1}, {0, 0, 1},
+    {0, 1, 0}, {1, 1, 0}, {1, 1, 1}, {0, 1, 1}
+};
+
+// Same loop nest as Chunk::buildMeshData; returns the number of surface cells
+template <typename Lookup>
+static int classifyCells(Lookup&& lookup)
+{
+    int surfaceCells = 0;
+    for (int x = 0; x < CHUNK_SIZE; ++x)
+        for (int y = 0; y < CHUNK_HEIGHT; ++y)
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+            {
+                int cubeIndex = 0;
+                for (int i = 0; i < 8; ++i)
+                    if (lookup(x + CORNER[i][0], y + CORNER[i][1], z + CORNER[i][2]) < 0.0f)
+                        cubeIndex |= 1 << i;
+
+                if (edgeTable[cubeIndex] != 0)
+                    ++surfaceCells;
+            }
+    return surfaceCells;
+}
+
+void benchDensityLayout()
+{
+    BiomeManager biome(1.0f, WATER_LEVEL_WORLD);
+    const glm::ivec2 chunkPos(3, -2);
+    const int iterations = 200;
+
+    // Column heights shared by every layout
+    std::vector<float> heights((CHUNK_SIZE + 3) * (CHUNK_SIZE + 3));
+    for (int x = -1; x <= CHUNK_SIZE + 1; ++x)
+        for (int z = -1; z <= CHUNK_SIZE + 1; ++z)
+            heights[(x + 1) * (CHUNK_SIZE + 3) + (z + 1)] = biome.sample(
+                float((x + chunkPos.x * CHUNK_SIZE) * VOXEL_SIZE),
+                float((z + chunkPos.y * CHUNK_SIZE) * VOXEL_SIZE)).height;
+
+    auto height = [&](int x, int z) { return heights[(x + 1) * (CHUNK_SIZE + 3) + (z + 1)]; };
+
+    char extra[64];
+
+    // Old layout: density[x][y][z]
+    {
+        NestedField nested;
+        double allocNs = nsPerOp([&]
+            {
+                nested.assign(CHUNK_SIZE + 1,
+                    std::vector<std::vector<float>>(CHUNK_HEIGHT + 1,
+                        std::vector<float>(CHUNK_SIZE + 1)));
+            }, iterations);
+
+        for (int x = 0; x <= CHUNK_SIZE; ++x)
+            for (int y = 0; y <= CHUNK_HEIGHT; ++y)
+                for (int z = 0; z <= CHUNK_SIZE; ++z)
+                    nested[x][y][z] = height(x, z) - y * VOXEL_SIZE;
+
+        int cells = 0;
+        double ns = nsPerOp([&]
+            {
+                cells = classifyCells([&](int x, int y, int z) { return nested[x][y][z]; });
+                benchSink = benchSink + cells;
+            }, iterations);
+
+        std::snprintf(extra, sizeof(extra), "%d surface cells", cells);
+        reportRow("nested vector: allocate", allocNs);
+        reportRow("nested vector: classify cells", ns, extra);
+    }
+
+    // New layout in every axis order
+    static const struct { AxisOrder order; const char* name; } orders[] = {
+        { AxisOrder::XYZ, "DensityGrid XYZ: classify cells" },
+        { AxisOrder::XZY, "DensityGrid XZY: classify cells" },
+        { AxisOrder::YXZ, "DensityGrid YXZ: classify cells" },
+        { AxisOrder::ZYX, "DensityGrid ZYX: classify cells" },
+    };
+
+    double allocNs = nsPerOp([&]
+        {
+            DensityGrid grid(CHUNK_SIZE + 1, CHUNK_HEIGHT + 1, CHUNK_SIZE + 1);
+            benchSink = benchSink + grid.at(0, 0, 0);
+        }, iterations);
+    reportRow("DensityGrid: allocate", allocNs);
+
+    for (const auto& o : orders)
+    {
+        DensityGrid grid(CHUNK_SIZE + 1, CHUNK_HEIGHT + 1, CHUNK_SIZE + 1, o.order);
+        for (int x = -1; x <= CHUNK_SIZE + 1; ++x)
+            for (int y = -1; y <= CHUNK_HEIGHT + 1; ++y)
+                for (int z = -1; z <= CHUNK_SIZE + 1; ++z)
+                    grid.at(x, y, z) = height(x, z) - y * VOXEL_SIZE;
+
+        // Gather corners the way polygoniseCube does: base pointer + corner offsets
+        std::ptrdiff_t offsets[8];
+        grid.cornerOffsets(offsets);
+
+        int cells = 0;
+        double ns = nsPerOp([&]
+            {
+                cells = 0;
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                    for (int y = 0; y < CHUNK_HEIGHT; ++y)
+                        for (int z = 0; z < CHUNK_SIZE; ++z)
+                        {
+                            const float* cube = grid.ptr(x, y, z);
+                            int cubeIndex = 0;
+                            for (int i = 0; i < 8; ++i)
+                                if (cube[offsets[i]] < 0.0f)
+                                    cubeIndex |= 1 << i;
+
+                            if (edgeTable[cubeIndex] != 0)
+                                ++cells;
+                        }
+                benchSink = benchSink + cells;
+            }, iterations);
+
+        std::snprintf(extra, sizeof(extra), "%d surface cells", cells);
+        reportRow(o.name, ns, extra);
+    }
+}
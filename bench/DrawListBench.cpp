@@ -0,0 +1,110 @@
+#include "Bench.h"
+#include "FakeArenaBackend.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+// The three forms of a command list must describe the same draws
+static bool listConsistent(const DrawCommandList& list)
+{
+    std::uint64_t triangles = 0;
+    for (std::size_t i = 0; i < list.drawCount(); ++i)
+    {
+        const DrawElementsIndirectCommand& c = list.commands()[i];
+        if (c.instanceCount != 1 || c.baseInstance != 0 ||
+            list.counts()[i] != int(c.count) ||
+            list.indexOffsets()[i] != reinterpret_cast<const void*>(std::size_t(c.firstIndex) * sizeof(unsigned int)) ||
+            list.baseVertices()[i] != c.baseVertex)
+            return false;
+        triangles += c.count / 3;
+    }
+    return triangles == list.triangleCount();
+}
+
+/* ------------------------- */
+/* Draw command list benchmark */
+/* Loads a square of chunk meshes into a MeshArena on the fake GPU, then */
+/* builds the per-frame command list for a camera turning in place and */
+/* submits it, checking every draw and the call count */
+/* ------------------------- */
+static void runScene(int radius)
+{
+    FakeArenaBackend gpu;
+    MeshArena arena(&gpu, 1 << 16, 3 << 16);
+
+    struct Placed
+    {
+        glm::vec2 centre;
+        MeshHandle handle;
+    };
+    std::vector<Placed> chunks;
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> size(200, 3000);
+    std::vector<PackedVertex> v;
+    std::vector<unsigned int> idx;
+    for (int z = -radius; z <= radius; ++z)
+    {
+        for (int x = -radius; x <= radius; ++x)
+        {
+            v.assign(std::size_t(size(rng)), PackedVertex{});
+            idx.resize(v.size() * 2 - v.size() % 3);
+            for (std::size_t i = 0; i < idx.size(); ++i)
+                idx[i] = unsigned(i % v.size());
+
+            glm::vec3 origin(float(x) * 16.0f, 0.0f, float(z) * 16.0f);
+            chunks.push_back({ glm::vec2(origin.x + 8.0f, origin.z + 8.0f), arena.allocate(v, idx, origin) });
+        }
+    }
+
+    // Visibility stands in for the frustum test: a 90 degree wedge around the view direction
+    DrawCommandList list;
+    const int frames = 360;
+    int frame = 0;
+    bool consistent = true;
+    std::size_t visibleTotal = 0, drawnTotal = 0;
+
+    arena.bind();
+    std::size_t submissionsBefore = gpu.submissions;
+    double ns = nsPerOp([&]
+    {
+        float angle = glm::radians(float(frame++ % frames));
+        glm::vec2 dir(std::cos(angle), std::sin(angle));
+
+        list.clear();
+        for (const Placed& c : chunks)
+        {
+            float along = glm::dot(c.centre, dir);
+            float across = c.centre.x * dir.y - c.centre.y * dir.x;
+            if (along > -16.0f && std::abs(across) <= along + 16.0f)
+            {
+                MeshArena::DrawRange r = arena.range(c.handle);
+                list.add(r.indexCount, r.firstIndex, r.baseVertex);
+            }
+            else
+            {
+                list.addCulled();
+            }
+        }
+
+        arena.submit(list);
+        visibleTotal += list.drawCount();
+        drawnTotal += list.drawCount();
+        consistent = consistent && list.drawCount() + list.culledCount() == chunks.size() && listConsistent(list);
+    }, frames);
+    std::size_t submissions = gpu.submissions - submissionsBefore;
+
+    char name[64], extra[128];
+    std::snprintf(name, sizeof(name), "radius %d (%zu chunks) build + submit", radius, chunks.size());
+    std::snprintf(extra, sizeof(extra), "%.0f draws/frame in %.2f calls/frame, %s, %s",
+        double(visibleTotal) / (frames + 1), double(submissions) / (frames + 1),
+        consistent && drawnTotal == gpu.draws ? "consistent" : "MISMATCH",
+        gpu.outOfBounds ? "OUT OF BOUNDS" : "in bounds");
+    reportRow(name, ns, extra);
+}
+
+void benchDrawCommands()
+{
+    runScene(8);
+    runScene(32);
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include "../include/MeshArena.h"
+#include <cstring>
+#include <map>
+#include <vector>
+
+/* ------------------------- */
+/* In-memory ArenaBackend: buffers are byte vectors, so every copy */
+/* and upload the arena issues can be checked without a GL context */
+/* ------------------------- */
+class FakeArenaBackend : public ArenaBackend
+{
+public:
+    std::map<unsigned, std::vector<unsigned char>> buffers;
+    std::map<unsigned, std::pair<unsigned, unsigned>> vertexArrays;   // vao -> (vbo, ebo)
+    std::map<unsigned, unsigned> textures;                            // texture -> buffer
+    unsigned nextId = 1;
+    unsigned boundVertexArray = 0, boundTexture = 0;
+    std::size_t draws = 0;            // Individual meshes drawn
+    std::size_t submissions = 0;      // Draw calls issued (a multi-draw counts once)
+    bool outOfBounds = false;
+
+    unsigned createBuffer(BufferKind, std::size_t bytes) override
+    {
+        buffers[nextId].assign(bytes, 0xCD);
+        return nextId++;
+    }
+
+    void destroyBuffer(unsigned buffer) override { buffers.erase(buffer); }
+
+    void uploadBuffer(unsigned buffer, std::size_t offset, const void* data, std::size_t bytes) override
+    {
+        std::vector<unsigned char>& b = buffers.at(buffer);
+        if (offset + bytes > b.size()) { outOfBounds = true; return; }
+        std::memcpy(b.data() + offset, data, bytes);
+    }
+
+    void copyBuffer(unsigned src, std::size_t srcOffset, unsigned dst, std::size_t dstOffset, std::size_t bytes) override
+    {
+        std::vector<unsigned char>& s = buffers.at(src);
+        std::vector<unsigned char>& d = buffers.at(dst);
+        if (srcOffset + bytes > s.size() || dstOffset + bytes > d.size()) { outOfBounds = true; return; }
+        std::memcpy(d.data() + dstOffset, s.data() + srcOffset, bytes);
+    }
+
+    unsigned createVertexArray(unsigned vertexBuffer, unsigned indexBuffer) override
+    {
+        vertexArrays[nextId] = { vertexBuffer, indexBuffer };
+        return nextId++;
+    }
+
+    void destroyVertexArray(unsigned vertexArray) override { vertexArrays.erase(vertexArray); }
+
+    unsigned createBufferTexture(unsigned buffer) override
+    {
+        textures[nextId] = buffer;
+        return nextId++;
+    }
+
+    void destroyTexture(unsigned texture) override { textures.erase(texture); }
+    void bindBufferTexture(unsigned texture) override { boundTexture = texture; }
+    void bindVertexArray(unsigned vertexArray) override { boundVertexArray = vertexArray; }
+
+    void drawElementsBaseVertex(unsigned indexCount, std::size_t firstIndex, int baseVertex) override
+    {
+        checkDraw(indexCount, firstIndex, baseVertex);
+        ++draws;
+        ++submissions;
+    }
+
+    void multiDraw(const DrawCommandList& list) override
+    {
+        for (const DrawElementsIndirectCommand& c : list.commands())
+            checkDraw(c.count, c.firstIndex, c.baseVertex);
+        draws += list.drawCount();
+        ++submissions;
+    }
+
+    // Origin stored in the bound page table for a vertex page
+    glm::vec3 pageOrigin(std::size_t page) const
+    {
+        const std::vector<unsigned char>& b = buffers.at(textures.at(boundTexture));
+        glm::vec4 origin;
+        std::memcpy(&origin, b.data() + page * sizeof(glm::vec4), sizeof(origin));
+        return glm::vec3(origin.x, origin.y, origin.z);
+    }
+
+private:
+    // A draw must stay inside the bound index buffer and start inside the vertex buffer
+    void checkDraw(unsigned indexCount, std::size_t firstIndex, int baseVertex)
+    {
+        const auto& vao = vertexArrays.at(boundVertexArray);
+        if ((firstIndex + indexCount) * sizeof(unsigned int) > buffers.at(vao.second).size() ||
+            std::size_t(baseVertex) * sizeof(PackedVertex) >= buffers.at(vao.first).size())
+            outOfBounds = true;
+    }
+};
@@ -0,0 +1,179 @@
+#include "Bench.h"
+#include "../include/ChunkGrid.h"
+#include "../include/Vec2Hash.h"
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// The hash World::chunks used before the grid
+struct XorShiftHash
+{
+    std::size_t operator()(const glm::ivec2& v) const
+    {
+        return std::hash<int>()(v.x) ^ (std::hash<int>()(v.y) << 1);
+    }
+};
+
+struct Vec2Less
+{
+    bool operator()(const glm::ivec2& a, const glm::ivec2& b) const
+    {
+        return a.x != b.x ? a.x < b.x : a.y < b.y;
+    }
+};
+
+// Chunk pointers are only compared, never dereferenced
+static Chunk* fakeChunk(std::uintptr_t n)
+{
+    return reinterpret_cast<Chunk*>(n * 16);
+}
+
+template <typename Map>
+static void runMap(const char* name, int radius, glm::ivec2 center)
+{
+    Map chunks;
+    for (int x = -radius; x <= radius; ++x)
+        for (int z = -radius; z <= radius; ++z)
+            chunks[center + glm::ivec2(x, z)] = fakeChunk(chunks.size() + 1);
+
+    char row[64], extra[96];
+    int window = 2 * radius + 1;
+    double ns = nsPerOp([&]
+        {
+            std::size_t found = 0;
+            for (int x = -radius; x <= radius; ++x)
+                for (int z = -radius; z <= radius; ++z)
+                    found += chunks.find(center + glm::ivec2(x, z)) != chunks.end();
+            benchSink = benchSink + double(found);
+        }, 200);
+    double iterNs = nsPerOp([&]
+        {
+            std::uintptr_t sum = 0;
+            for (const auto& entry : chunks)
+                sum += reinterpret_cast<std::uintptr_t>(entry.second);
+            benchSink = benchSink + double(sum);
+        }, 200);
+
+    std::snprintf(row, sizeof(row), "%s lookup", name);
+    std::snprintf(extra, sizeof(extra), "%.1f ns/lookup, iterate %.1f ns/chunk, %zu buckets",
+        ns / (window * window), iterNs / (window * window), chunks.bucket_count());
+    reportRow(row, ns, extra);
+}
+
+static void runGrid(int radius, glm::ivec2 center)
+{
+    ChunkGrid chunks(2 * radius + 1);
+    for (int x = -radius; x <= radius; ++x)
+        for (int z = -radius; z <= radius; ++z)
+            chunks.insert(center + glm::ivec2(x, z), fakeChunk(chunks.size() + 1));
+
+    char extra[96];
+    int window = 2 * radius + 1;
+    double ns = nsPerOp([&]
+        {
+            std::size_t found = 0;
+            for (int x = -radius; x <= radius; ++x)
+                for (int z = -radius; z <= radius; ++z)
+                    found += chunks.contains(center + glm::ivec2(x, z));
+            benchSink = benchSink + double(found);
+        }, 200);
+    double iterNs = nsPerOp([&]
+        {
+            std::uintptr_t sum = 0;
+            for (const ChunkGrid::Entry& entry : chunks)
+                sum += reinterpret_cast<std::uintptr_t>(entry.chunk);
+            benchSink = benchSink + double(sum);
+        }, 200);
+
+    std::snprintf(extra, sizeof(extra), "%.1f ns/lookup, iterate %.1f ns/chunk, no heap nodes",
+        ns / (window * window), iterNs / (window * window));
+    reportRow("ChunkGrid lookup", ns, extra);
+}
+
+/* ------------------------- */
+/* Camera walk: the grid must always hold exactly the chunks a map */
+/* would after the same loads and unloads (stale slots handed back) */
+/* ------------------------- */
+static bool walkMatchesMap(int loadRadius, int unloadRadius, int steps)
+{
+    ChunkGrid grid(2 * unloadRadius + 1);
+    std::map<glm::ivec2, Chunk*, Vec2Less> reference;
+    std::mt19937 rng(9);
+    glm::ivec2 camera(0);
+    std::uintptr_t next = 1;
+
+    for (int step = 0; step < steps; ++step)
+    {
+        camera += glm::ivec2(int(rng() % 3) - 1, int(rng() % 3) - 1);
+
+        // Load a few positions in range, in random order like finished jobs
+        for (int i = 0; i < 8; ++i)
+        {
+            glm::ivec2 pos = camera + glm::ivec2(int(rng() % (2 * loadRadius + 1)) - loadRadius,
+                int(rng() % (2 * loadRadius + 1)) - loadRadius);
+            if (grid.contains(pos))
+                continue;
+
+            Chunk* chunk = fakeChunk(next++);
+            if (Chunk* stale = grid.insert(pos, chunk))
+            {
+                // Only chunks that are out of range may be displaced
+                auto it = std::find_if(reference.begin(), reference.end(),
+                    [&](const std::pair<const glm::ivec2, Chunk*>& e) { return e.second == stale; });
+                if (it == reference.end() || std::max(std::abs(it->first.x - camera.x), std::abs(it->first.y - camera.y)) <= unloadRadius)
+                    return false;
+                reference.erase(it);
+            }
+            reference[pos] = chunk;
+        }
+
+        // Unload every few steps, like the throttled update
+        if (step % 4 == 0)
+        {
+            for (auto it = reference.begin(); it != reference.end();)
+            {
+                if (std::max(std::abs(it->first.x - camera.x), std::abs(it->first.y - camera.y)) > unloadRadius)
+                {
+                    if (grid.erase(it->first) != it->second)
+                        return false;
+                    it = reference.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+
+        if (grid.size() != reference.size())
+            return false;
+        for (const auto& entry : reference)
+            if (grid.find(entry.first) != entry.second)
+                return false;
+    }
+    return true;
+}
+
+/* ------------------------- */
+/* Chunk container benchmark */
+/* Lookups over a whole load window and full iteration: unordered_map */
+/* with the old and a mixing hash vs the toroidal ChunkGrid */
+/* ------------------------- */
+void benchChunkGrid()
+{
+    int radii[] = { 8, 32 };
+    for (int radius : radii)
+    {
+        glm::ivec2 center(-radius / 2, radius / 3);
+        std::printf("  radius %d (%d chunks)\n", radius, (2 * radius + 1) * (2 * radius + 1));
+        runMap<std::unordered_map<glm::ivec2, Chunk*, XorShiftHash>>("unordered_map, x^(y<<1)", radius, center);
+        runMap<std::unordered_map<glm::ivec2, Chunk*, Vec2Hash>>("unordered_map, mixing hash", radius, center);
+        runGrid(radius, center);
+    }
+
+    std::printf("  camera walk (10000 steps, load 8 / unload 10): %s\n",
+        walkMatchesMap(8, 10, 10000) ? "grid matches map" : "MISMATCH");
+}
@@ -0,0 +1,128 @@
+#include "Bench.h"
+#include "SimClock.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+/* ------------------------- */
+/* Headless World flythrough */
+/* Drives the real World (streaming, LOD, finalize, culling, draw list) */
+/* on a RecordingArenaBackend and a SimClock: 60 Hz frames, uploads */
+/* that cost simulated time per byte so the upload budget still defers */
+/* work, and generation charged per chunk. Each frame waits for the workers before updating, and */
+/* World finalizes in distance order rather than completion order, so */
+/* every counter is reproducible however the workers interleave; two */
+/* runs must agree exactly. Only the CPU times vary from run to run */
+/* ------------------------- */
+
+namespace
+{
+    const double FRAME_SECONDS = 1.0 / 60.0;
+    const int FRAMES = 600;                          // 10 simulated seconds
+    const int WORKERS = 4;
+
+    // Ocean to coast to land along +x at two chunks per second
+    const float CHUNK_WORLD = float(CHUNK_SIZE * VOXEL_SIZE);
+    const glm::vec3 PATH_START(-72.0f * CHUNK_WORLD, 300.0f, 0.5f * CHUNK_WORLD);
+    const glm::vec3 PATH_VELOCITY(2.0f * CHUNK_WORLD, 0.0f, 0.0f);
+
+    struct FlightResult
+    {
+        RecordingArenaBackend::Counters gpu;
+        StreamingStats streaming;
+        std::size_t loadedChunks = 0;
+        std::uint64_t framesWithUploads = 0, overrunFrames = 0;
+        double updateMs = 0.0, drawMs = 0.0, worstFrameMs = 0.0;   // Not reproducible
+    };
+
+    FlightResult fly()
+    {
+        RecordingArenaBackend backend;
+        SimClock clock(backend, WORKERS);
+
+        WorldConfig config;
+        config.backend = &backend;
+        config.clock = clock.function();
+        config.regionCacheDir = "";    // Every chunk is generated
+        config.workerThreads = WORKERS;
+
+        FlightResult result;
+        {
+            World world(config);
+            glm::mat4 projection = glm::perspective(glm::radians(90.0f), 800.0f / 600.0f, 0.1f, 10000.0f);
+
+            for (int frame = 0; frame < FRAMES; ++frame)
+            {
+                double frameTime = frame * FRAME_SECONDS;
+                glm::vec3 camera = PATH_START + PATH_VELOCITY * float(frameTime);
+                glm::mat4 view = glm::lookAt(camera, camera + glm::vec3(1.0f, -0.3f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+                world.waitForWorkers();
+                clock.startFrame(frameTime, world);
+                auto start = std::chrono::steady_clock::now();
+                world.update(camera);
+                auto updated = std::chrono::steady_clock::now();
+                world.submitDraws(projection * view);
+                auto drawn = std::chrono::steady_clock::now();
+
+                double updateMs = std::chrono::duration<double, std::milli>(updated - start).count();
+                double drawMs = std::chrono::duration<double, std::milli>(drawn - updated).count();
+                result.updateMs += updateMs;
+                result.drawMs += drawMs;
+                result.worstFrameMs = std::max(result.worstFrameMs, updateMs + drawMs);
+            }
+
+            world.waitForWorkers();
+            result.streaming = world.streamingStats();
+            result.loadedChunks = world.meshArenaStats().liveMeshes;
+            result.framesWithUploads = world.finalizeBudget().stats().frames;
+            result.overrunFrames = world.finalizeBudget().stats().overrunFrames;
+        }
+        result.gpu = backend.counters();   // Including the arena's teardown
+        return result;
+    }
+
+    // The counters that must not change between runs
+    bool sameCounters(const FlightResult& a, const FlightResult& b)
+    {
+        return std::memcmp(&a.gpu, &b.gpu, sizeof(a.gpu)) == 0
+            && std::memcmp(&a.streaming, &b.streaming, sizeof(a.streaming)) == 0
+            && a.loadedChunks == b.loadedChunks && a.framesWithUploads == b.framesWithUploads
+            && a.overrunFrames == b.overrunFrames;
+    }
+}
+
+void benchHeadlessWorld()
+{
+    FlightResult first = fly();
+    FlightResult second = fly();
+    const RecordingArenaBackend::Counters& gpu = first.gpu;
+    char extra[128];
+
+    std::printf("  %d frames at 60 Hz, camera from chunk (%d,%d) along +x at 2 chunks/s, %d workers\n",
+        FRAMES, int(PATH_START.x / CHUNK_WORLD), int(PATH_START.z / CHUNK_WORLD), WORKERS);
+    std::printf("  streaming: %llu generated, %llu wasted, %llu cancelled, %zu meshes loaded at the end\n",
+        (unsigned long long)first.streaming.generated, (unsigned long long)first.streaming.wasted,
+        (unsigned long long)first.streaming.cancelled, first.loadedChunks);
+    std::printf("  finalize: uploads in %llu frames, %llu over budget\n",
+        (unsigned long long)first.framesWithUploads, (unsigned long long)first.overrunFrames);
+    std::printf("  gpu buffers: %llu created (%.1f MB), %llu uploads (%.1f MB), %llu copies (%.1f MB)\n",
+        (unsigned long long)gpu.buffersCreated, gpu.bufferBytesCreated / double(1 << 20),
+        (unsigned long long)gpu.uploads, gpu.bytesUploaded / double(1 << 20),
+        (unsigned long long)gpu.copies, gpu.bytesCopied / double(1 << 20));
+    std::printf("  gpu draws: %llu draw calls, %.1f ranges and %.0f triangles per frame\n",
+        (unsigned long long)gpu.drawCalls, double(gpu.rangesDrawn) / FRAMES, double(gpu.trianglesDrawn) / FRAMES);
+    std::printf("  gpu state: %llu binding changes, %llu redundant binds, %llu invalid calls\n",
+        (unsigned long long)gpu.stateChanges, (unsigned long long)gpu.redundantBinds, (unsigned long long)gpu.errors);
+
+    std::snprintf(extra, sizeof(extra), "worst frame %.2f ms", std::max(first.worstFrameMs, second.worstFrameMs));
+    reportRow("World::update per frame", (first.updateMs + second.updateMs) * 1e6 / (2 * FRAMES), extra);
+    reportRow("World::submitDraws per frame", (first.drawMs + second.drawMs) * 1e6 / (2 * FRAMES));
+
+    bool reproducible = benchCheck(sameCounters(first, second), "two headless runs differ");
+    bool valid = benchCheck(gpu.errors == 0, "the world issued invalid GPU calls");
+    if (reproducible && valid)
+        std::printf("  two runs agree on every counter, no invalid GPU calls\n");
+    benchSink = benchSink + double(gpu.trianglesDrawn);
+}
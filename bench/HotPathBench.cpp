@@ -0,0 +1,218 @@
+#include "Bench.h"
+#include "../include/Chunk.h"
+#include <algorithm>
+#include <vector>
+
+/* ------------------------- */
+/* Terrain generation hot paths, one function at a time */
+/* Fixed seed and fixed chunks: open ocean, a coast and hills, which */
+/* differ in mesh size and in how deep the surface band is. The biome */
+/* functions run over a chunk's column lattice (colours at the surface */
+/* height); the chunk stages over the whole LOD 0 chunk, without the */
+/* heightmap tile cache */
+/* ------------------------- */
+
+/* ------------------------- */
+/* Private Chunk stages, exposed to this file only (friend of Chunk) */
+/* ------------------------- */
+struct ChunkStages
+{
+    static void densityField(Chunk& chunk)
+    {
+        chunk.generateDensityField();
+    }
+
+    // Every cube of the chunk, not just the height bands buildMeshData visits
+    static void polygoniseAll(Chunk& chunk, std::vector<PackedVertex>& vertices, std::vector<unsigned int>& indices)
+    {
+        vertices.clear();
+        indices.clear();
+        Chunk::EdgeCache edgeCache(chunk.layers, chunk.cells);
+        for (int x = 0; x < chunk.cells; ++x)
+        {
+            for (int z = 0; z < chunk.cells; ++z)
+                for (int y = 0; y < chunk.layers; ++y)
+                    chunk.polygoniseCube(x, y, z, vertices, indices, edgeCache, 0.0f);
+            edgeCache.advance();
+        }
+    }
+
+    static void meshData(Chunk& chunk, std::vector<PackedVertex>& vertices, std::vector<unsigned int>& indices)
+    {
+        chunk.dirty = true;   // Otherwise buildMeshData keeps the last mesh
+        chunk.buildMeshData(vertices, indices);
+    }
+
+    static int cubesMeshed(const Chunk& chunk)
+    {
+        int cubes = 0;
+        for (const Chunk::CellBand& band : chunk.cellBands)
+            cubes += std::max(band.yMax - band.yMin + 1, 0);
+        return cubes;
+    }
+};
+
+namespace
+{
+    struct TerrainCase
+    {
+        const char* name;
+        glm::ivec2 chunk;
+    };
+
+    // Picked with DEFAULT_TERRAIN_SEED by ocean weight, height range and how
+    // many columns nearOcean flags. It flags every column with a biome mask
+    // below 0.75 nearby, which takes in all of the ocean, every shore and
+    // most of the plains, so only an inland chunk can mix both answers
+    const TerrainCase CASES[] = {
+        { "ocean", glm::ivec2(-96, 0) },    // Flat sea floor, ocean weight 1, all near ocean
+        { "coast", glm::ivec2(-92, 40) },   // Shore rising from the sea floor onto plains, all near ocean
+        { "hills", glm::ivec2(-28, 0) },    // Inland plains at the top of the height range, all near ocean
+        { "upland", glm::ivec2(6, 6) },     // Inland plains where the mask peaks, about half near ocean
+    };
+
+    const int POINT_PASSES = 20;    // Passes over the column lattice per biome timing
+    const int CHUNK_PASSES = 30;    // Calls per chunk-stage timing
+
+    void benchCase(const TerrainCase& c, const BiomeManager& biome, const PlainsBiome& plains, const OceanBiome& ocean)
+    {
+        // LOD 0 column lattice with its apron, as generateDensityField samples it
+        const int side = CHUNK_SIZE + 3;
+        std::vector<glm::vec2> points;
+        std::vector<BiomeSample> samples;
+        for (int x = -1; x <= CHUNK_SIZE + 1; ++x)
+            for (int z = -1; z <= CHUNK_SIZE + 1; ++z)
+            {
+                glm::vec2 p(float((c.chunk.x * CHUNK_SIZE + x) * VOXEL_SIZE), float((c.chunk.y * CHUNK_SIZE + z) * VOXEL_SIZE));
+                points.push_back(p);
+                samples.push_back(biome.sample(p.x, p.y));
+            }
+        const double perPoint = 1.0 / (double(points.size()) * POINT_PASSES);
+
+        Chunk chunk(c.chunk, &biome);
+        std::vector<PackedVertex> vertices;
+        std::vector<unsigned int> indices;
+        chunk.generateData(vertices, indices);
+        std::size_t triangles = indices.size() / 3, meshVertices = vertices.size();
+
+        int nearCount = 0;
+        std::vector<bool> near;
+        for (const glm::vec2& p : points)
+        {
+            near.push_back(biome.nearOcean(p.x, p.y));
+            nearCount += near.back() ? 1 : 0;
+        }
+        const int latticePoints = (CHUNK_SIZE / NEAR_OCEAN_SPACING + 1) * (CHUNK_SIZE / NEAR_OCEAN_SPACING + 1);
+
+        char label[64], extra[96];
+        std::printf("  %s chunk (%d,%d): %zu triangles, %zu vertices per chunk\n",
+            c.name, c.chunk.x, c.chunk.y, triangles, meshVertices);
+
+        // Per sample: generateDensityField samples every column once (batched)
+        // and nearOcean once per lattice point; surfaceVertex only calls surfaceColor
+        double ns = nsPerOp([&]
+            {
+                float sum = 0.0f;
+                for (int pass = 0; pass < POINT_PASSES; ++pass)
+                    for (const glm::vec2& p : points)
+                        sum += biome.sample(p.x, p.y).height;
+                benchSink = benchSink + sum;
+            }, 1) * perPoint;
+        std::snprintf(label, sizeof(label), "%s BiomeManager::sample", c.name);
+        std::snprintf(extra, sizeof(extra), "%d column samples per chunk", side * side);
+        reportRow(label, ns, extra);
+
+        ns = nsPerOp([&]
+            {
+                int hits = 0;
+                for (int pass = 0; pass < POINT_PASSES; ++pass)
+                    for (const glm::vec2& p : points)
+                        hits += biome.nearOcean(p.x, p.y) ? 1 : 0;
+                benchSink = benchSink + hits;
+            }, 1) * perPoint;
+        std::snprintf(label, sizeof(label), "%s BiomeManager::nearOcean", c.name);
+        std::snprintf(extra, sizeof(extra), "%.0f%% near ocean, %d lattice points per chunk",
+            100.0 * nearCount / double(points.size()), latticePoints);
+        reportRow(label, ns, extra);
+
+        ns = nsPerOp([&]
+            {
+                float sum = 0.0f;
+                for (int pass = 0; pass < POINT_PASSES; ++pass)
+                    for (std::size_t i = 0; i < points.size(); ++i)
+                        sum += biome.surfaceColor(samples[i].height, samples[i].oceanWeight, near[i]).y;
+                benchSink = benchSink + sum;
+            }, 1) * perPoint;
+        std::snprintf(label, sizeof(label), "%s BiomeManager::surfaceColor", c.name);
+        std::snprintf(extra, sizeof(extra), "%zu vertices per chunk", meshVertices);
+        reportRow(label, ns, extra);
+
+        ns = nsPerOp([&]
+            {
+                float sum = 0.0f;
+                for (int pass = 0; pass < POINT_PASSES; ++pass)
+                    for (const glm::vec2& p : points)
+                        sum += plains.getHeight(p.x, p.y);
+                benchSink = benchSink + sum;
+            }, 1) * perPoint;
+        std::snprintf(label, sizeof(label), "%s PlainsBiome::getHeight", c.name);
+        reportRow(label, ns);
+
+        ns = nsPerOp([&]
+            {
+                float sum = 0.0f;
+                for (int pass = 0; pass < POINT_PASSES; ++pass)
+                    for (const glm::vec2& p : points)
+                        sum += ocean.getHeight(p.x, p.y);
+                benchSink = benchSink + sum;
+            }, 1) * perPoint;
+        std::snprintf(label, sizeof(label), "%s OceanBiome::getHeight", c.name);
+        reportRow(label, ns);
+
+        // Chunk stages, ns per chunk
+        ns = nsPerOp([&] { ChunkStages::densityField(chunk); }, CHUNK_PASSES);
+        std::snprintf(label, sizeof(label), "%s Chunk::generateDensityField", c.name);
+        std::snprintf(extra, sizeof(extra), "%d columns sampled", side * side);
+        reportRow(label, ns, extra);
+
+        std::size_t allTriangles = 0;
+        ns = nsPerOp([&]
+            {
+                ChunkStages::polygoniseAll(chunk, vertices, indices);
+                allTriangles = indices.size() / 3;
+            }, CHUNK_PASSES);
+        std::snprintf(label, sizeof(label), "%s Chunk::polygoniseCube (all cubes)", c.name);
+        std::snprintf(extra, sizeof(extra), "%d cubes, %.1f ns/cube, %zu triangles",
+            CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE, ns / (CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE), allTriangles);
+        reportRow(label, ns, extra);
+
+        ns = nsPerOp([&] { ChunkStages::meshData(chunk, vertices, indices); }, CHUNK_PASSES);
+        std::snprintf(label, sizeof(label), "%s Chunk::buildMeshData", c.name);
+        std::snprintf(extra, sizeof(extra), "%d cubes in bands, %zu triangles", ChunkStages::cubesMeshed(chunk), indices.size() / 3);
+        reportRow(label, ns, extra);
+
+        ns = nsPerOp([&]
+            {
+                Chunk fresh(c.chunk, &biome);
+                fresh.generateData(vertices, indices);
+                benchSink = benchSink + double(indices.size());
+            }, CHUNK_PASSES);
+        std::snprintf(label, sizeof(label), "%s Chunk::generateData", c.name);
+        std::snprintf(extra, sizeof(extra), "%.1f ns/triangle", ns / double(triangles ? triangles : 1));
+        reportRow(label, ns, extra);
+    }
+}
+
+void benchHotPaths()
+{
+    // As World builds them: voxelScale 1, the game's water level and seed
+    const float voxelScale = float(VOXEL_SIZE) / DESIGN_VOXEL;
+    BiomeManager biome(voxelScale, WATER_LEVEL_WORLD, DEFAULT_TERRAIN_SEED);
+    PlainsBiome plains(voxelScale, WATER_LEVEL_WORLD, DEFAULT_TERRAIN_SEED);
+    OceanBiome ocean(voxelScale, WATER_LEVEL_WORLD, DEFAULT_TERRAIN_SEED);
+
+    std::printf("  biome rows are ns per call over each chunk's %d columns; chunk rows are ns per chunk\n",
+        (CHUNK_SIZE + 3) * (CHUNK_SIZE + 3));
+    for (const TerrainCase& c : CASES)
+        benchCase(c, biome, plains, ocean);
+}
@@ -0,0 +1,158 @@
+#include "Bench.h"
+#include "../include/JobSystem.h"
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/* ------------------------- */
+/* Job dispatch benchmark */
+/* Bursts of 289 jobs (one radius-8 window) through the old single */
+/* mutex + priority_queue pool and through JobSystem */
+/* ------------------------- */
+
+static const int BURST = 289;
+static const int BURSTS = 40;
+
+// Roughly 5 us of arithmetic, standing in for a small chunk stage
+static void syntheticWork(int seed)
+{
+    double acc = seed;
+    for (int i = 0; i < 1500; ++i)
+        acc = std::sin(acc) + 1.0;
+    benchSink = benchSink + acc;
+}
+
+/* -------------------------- */
+/* Replica of the previous World worker pool */
+/* -------------------------- */
+class MutexQueuePool
+{
+public:
+    explicit MutexQueuePool(int threads)
+    {
+        for (int i = 0; i < threads; ++i)
+            workers.emplace_back([this] { loop(); });
+    }
+
+    ~MutexQueuePool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+        }
+        condition.notify_all();
+        for (auto& w : workers)
+            w.join();
+    }
+
+    void submitBurst(int count)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int i = 0; i < count; ++i)
+            tasks.push({ i, float(i % 17) });
+        pending += count;
+        condition.notify_one();  // As World::queueChunks did
+    }
+
+    void waitIdle()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return pending == 0; });
+    }
+
+    double busySeconds() const { return busyNanos.load() * 1e-9; }
+
+private:
+    struct Task
+    {
+        int seed;
+        float distance;
+        bool operator<(const Task& o) const { return distance > o.distance; }
+    };
+
+    std::priority_queue<Task> tasks;
+    std::mutex mutex;
+    std::condition_variable condition, idle;
+    std::vector<std::thread> workers;
+    bool running = true;
+    int pending = 0;
+    std::atomic<long long> busyNanos{ 0 };
+
+    void loop()
+    {
+        while (true)
+        {
+            Task t;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [this] { return !tasks.empty() || !running; });
+                if (!running && tasks.empty())
+                    return;
+                t = tasks.top();
+                tasks.pop();
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            syntheticWork(t.seed);
+            busyNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0)
+                idle.notify_all();
+        }
+    }
+};
+
+static void report(const char* pool, int threads, double seconds, double busy)
+{
+    const double tasks = double(BURST) * BURSTS;
+    char name[64], extra[96];
+    std::snprintf(name, sizeof(name), "%s, %d threads", pool, threads);
+    std::snprintf(extra, sizeof(extra), "%10.0f tasks/s, %5.1f%% utilisation",
+        tasks / seconds, 100.0 * busy / (seconds * threads));
+    reportRow(name, seconds * 1e9 / tasks, extra);
+}
+
+void benchJobSystem()
+{
+    std::printf("  %d bursts of %d jobs, %u hardware threads\n",
+        BURSTS, BURST, std::thread::hardware_concurrency());
+
+    for (int threads : { 4, 16, 64 })
+    {
+        {
+            MutexQueuePool pool(threads);
+            auto start = std::chrono::steady_clock::now();
+            for (int b = 0; b < BURSTS; ++b)
+            {
+                pool.submitBurst(BURST);
+                pool.waitIdle();
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            report("mutex priority_queue", threads, seconds, pool.busySeconds());
+        }
+
+        {
+            JobSystem pool(threads);
+            auto start = std::chrono::steady_clock::now();
+            for (int b = 0; b < BURSTS; ++b)
+            {
+                std::vector<JobSystem::PrioritizedJob> batch;
+                for (int i = 0; i < BURST; ++i)
+                    batch.push_back({ [i] { syntheticWork(i); }, i % JobSystem::PRIORITY_LEVELS });
+                pool.submitBatch(std::move(batch));
+                pool.waitIdle();
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            JobSystem::Stats s = pool.stats();
+            report("JobSystem", threads, seconds, s.busySeconds);
+            std::printf("  %-40s %llu executed, %llu stolen\n", "",
+                (unsigned long long)s.executed, (unsigned long long)s.stolen);
+        }
+    }
+}
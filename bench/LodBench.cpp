@@ -0,0 +1,208 @@
+#include "Bench.h"
+#include "../include/Chunk.h"
+#include "../include/HeightTileCache.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+/* ------------------------- */
+/* LOD meshing benchmark and seam test */
+/* Meshes a square of chunks whose LOD steps up one level per ring band, */
+/* welds every triangle by quantized world position and looks for */
+/* directed edges without an opposite twin. Inside the square there must */
+/* be none: a crack, T-junction or mis-wound transition strip shows up */
+/* as an unmatched edge. The same square without the strips must fail */
+/* ------------------------- */
+
+namespace
+{
+    // Outermost ring of each LOD but the last; neighbours differ by at most one level
+    const int TEST_LOD_RADIUS[LOD_LEVELS - 1] = { 1, 3, 5 };
+    const int TEST_RADIUS = 7;
+
+    int testLod(glm::ivec2 offset)
+    {
+        int d = std::max(std::abs(offset.x), std::abs(offset.y));
+        int lod = 0;
+        while (lod < LOD_LEVELS - 1 && d > TEST_LOD_RADIUS[lod])
+            ++lod;
+        return lod;
+    }
+
+    struct MeshedChunk
+    {
+        Chunk* chunk;
+        std::vector<PackedVertex> vertices;
+        std::vector<unsigned int> indices;
+    };
+
+    struct SeamResult
+    {
+        std::size_t triangles = 0;
+        std::size_t unmatched = 0;     // Interior directed edges with no twin
+        std::size_t duplicated = 0;    // Directed edges used twice (inconsistent winding)
+    };
+
+    // Quantized world position of a vertex, packed into one key
+    std::uint64_t weldKey(const PackedVertex& v, glm::ivec2 chunkPos)
+    {
+        const std::int64_t chunkSteps = std::int64_t(CHUNK_SIZE) * VOXEL_SIZE * POSITION_STEPS_PER_UNIT;
+        std::int64_t x = v.position[0] + chunkPos.x * chunkSteps + (std::int64_t(1) << 23);
+        std::int64_t z = v.position[2] + chunkPos.y * chunkSteps + (std::int64_t(1) << 23);
+        return (std::uint64_t(x) << 40) | (std::uint64_t(z) << 16) | v.position[1];
+    }
+
+    SeamResult checkSeams(const std::vector<MeshedChunk>& meshes, glm::ivec2 center, bool withTransitions)
+    {
+        std::unordered_map<std::uint64_t, std::uint32_t> welded;
+        std::vector<std::uint64_t> positions;
+        std::unordered_map<std::uint64_t, int> edges;
+        SeamResult result;
+
+        auto weld = [&](std::uint64_t key)
+        {
+            auto it = welded.find(key);
+            if (it != welded.end())
+                return it->second;
+            std::uint32_t id = std::uint32_t(positions.size());
+            welded[key] = id;
+            positions.push_back(key);
+            return id;
+        };
+
+        auto addRange = [&](const MeshedChunk& m, Chunk::IndexRange range)
+        {
+            for (unsigned i = range.first; i < range.first + range.count; i += 3)
+            {
+                std::uint32_t t[3];
+                for (int k = 0; k < 3; ++k)
+                    t[k] = weld(weldKey(m.vertices[m.indices[i + k]], m.chunk->position));
+
+                // Zero-length edges vanish once welded
+                if (t[0] == t[1] || t[1] == t[2] || t[2] == t[0])
+                    continue;
+
+                result.triangles++;
+                for (int k = 0; k < 3; ++k)
+                    edges[(std::uint64_t(t[k]) << 32) | t[(k + 1) % 3]]++;
+            }
+        };
+
+        std::unordered_map<std::uint64_t, int> lodAt;
+        auto posKey = [](glm::ivec2 p) { return (std::uint64_t(std::uint32_t(p.x)) << 32) | std::uint32_t(p.y); };
+        for (const MeshedChunk& m : meshes)
+            lodAt[posKey(m.chunk->position)] = m.chunk->lod();
+
+        for (const MeshedChunk& m : meshes)
+        {
+            addRange(m, m.chunk->regularIndices());
+            if (!withTransitions)
+                continue;
+
+            // Same rule as World::buildDrawCommands: strips towards finer neighbours
+            for (int face = 0; face < Chunk::FACE_COUNT; ++face)
+            {
+                auto it = lodAt.find(posKey(m.chunk->position + Chunk::faceDirection(face)));
+                if (it != lodAt.end() && it->second < m.chunk->lod())
+                    addRange(m, m.chunk->transitionIndices(face));
+            }
+        }
+
+        // Edges on the outside of the square have nothing to meet
+        const std::int64_t chunkSteps = std::int64_t(CHUNK_SIZE) * VOXEL_SIZE * POSITION_STEPS_PER_UNIT;
+        const std::int64_t lo[2] = { (center.x - TEST_RADIUS) * chunkSteps, (center.y - TEST_RADIUS) * chunkSteps };
+        const std::int64_t hi[2] = { (center.x + TEST_RADIUS + 1) * chunkSteps, (center.y + TEST_RADIUS + 1) * chunkSteps };
+        auto onRim = [&](std::uint64_t key, int axis)
+        {
+            std::int64_t c = std::int64_t((key >> (axis == 0 ? 40 : 16)) & 0xFFFFFF) - (std::int64_t(1) << 23);
+            return c == lo[axis] || c == hi[axis];
+        };
+
+        for (const auto& e : edges)
+        {
+            std::uint32_t a = std::uint32_t(e.first >> 32), b = std::uint32_t(e.first);
+            if (e.second > 1)
+                result.duplicated++;
+
+            if (edges.count((std::uint64_t(b) << 32) | a))
+                continue;
+
+            bool rim = false;
+            for (int axis = 0; axis < 2; ++axis)
+                rim |= onRim(positions[a], axis) && onRim(positions[b], axis);
+            if (!rim)
+                result.unmatched++;
+        }
+        return result;
+    }
+}
+
+void benchLodMeshing()
+{
+    struct Case
+    {
+        const char* name;
+        glm::ivec2 center;
+    };
+    const Case cases[] = {
+        { "ocean", glm::ivec2(-51, 18) },
+        { "coast", glm::ivec2(-48, 0) },
+        { "hills", glm::ivec2(-15, -42) },
+    };
+
+    BiomeManager biome(1.0f, WATER_LEVEL_WORLD);
+    bool allClosed = true;
+    char label[64], extra[96];
+
+    for (const Case& c : cases)
+    {
+        // LOD 0 goes through the tile cache like World; coarser LODs sample directly
+        HeightTileCache tiles(&biome, 512);
+        std::vector<MeshedChunk> meshes;
+        double lodNs[LOD_LEVELS] = {};
+        std::size_t lodTriangles[LOD_LEVELS] = {}, lodChunks[LOD_LEVELS] = {};
+
+        for (int x = -TEST_RADIUS; x <= TEST_RADIUS; ++x)
+            for (int z = -TEST_RADIUS; z <= TEST_RADIUS; ++z)
+            {
+                int lod = testLod(glm::ivec2(x, z));
+                MeshedChunk m;
+                m.chunk = new Chunk(c.center + glm::ivec2(x, z), &biome, &tiles, lod);
+
+                auto start = std::chrono::steady_clock::now();
+                m.chunk->generateData(m.vertices, m.indices);
+                lodNs[lod] += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+                lodTriangles[lod] += m.chunk->regularIndices().count / 3;
+                lodChunks[lod]++;
+
+                meshes.push_back(std::move(m));
+            }
+
+        std::printf("  %s (chunk %d,%d), %d chunks\n", c.name, c.center.x, c.center.y,
+            (2 * TEST_RADIUS + 1) * (2 * TEST_RADIUS + 1));
+        for (int lod = 0; lod < LOD_LEVELS; ++lod)
+        {
+            std::snprintf(label, sizeof(label), "generateData LOD %d (stride %d)", lod, 1 << lod);
+            std::snprintf(extra, sizeof(extra), "%zu triangles/chunk over %zu chunks",
+                lodTriangles[lod] / lodChunks[lod], lodChunks[lod]);
+            reportRow(label, lodNs[lod] / lodChunks[lod], extra);
+        }
+
+        SeamResult closed = checkSeams(meshes, c.center, true);
+        SeamResult open = checkSeams(meshes, c.center, false);
+        std::printf("  seams with transition strips: %zu open edges, %zu doubled (%zu triangles)\n",
+            closed.unmatched, closed.duplicated, closed.triangles);
+        std::printf("  seams without: %zu open edges\n", open.unmatched);
+
+        allClosed &= closed.unmatched == 0 && closed.duplicated == 0 && open.unmatched > 0;
+        benchSink = benchSink + double(closed.triangles);
+
+        for (MeshedChunk& m : meshes)
+            delete m.chunk;
+    }
+
+    if (benchCheck(allClosed, "cracks across LOD boundaries (or seams close without the strips)"))
+        std::printf("  watertight across every LOD boundary\n");
+}
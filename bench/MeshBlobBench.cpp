@@ -0,0 +1,161 @@
+#include "Bench.h"
+#include "FakeArenaBackend.h"
+#include "../include/Chunk.h"
+#include "../include/HeightTileCache.h"
+#include "../include/MeshBlob.h"
+#include <cstring>
+#include <vector>
+
+/* ------------------------- */
+/* Mesh blob round trip */
+/* Serializes real chunk meshes at every LOD, reads them back in place */
+/* and checks the arrays and MeshInfo byte for byte, then uploads the */
+/* fresh arrays and the blob view to two fake GPUs, whose buffers must */
+/* match. Damaged blobs (payload, counts, version, size, alignment) */
+/* must all be rejected */
+/* ------------------------- */
+
+namespace
+{
+    struct Corruption
+    {
+        const char* name;
+        std::size_t rejected = 0, tried = 0;
+    };
+
+    // Reads a damaged copy of blob; true if readMeshBlob refused it
+    template <typename F>
+    bool rejects(const std::vector<unsigned char>& blob, F&& damage)
+    {
+        // Aligned copy with room behind it, so damage can also shift the blob
+        std::vector<unsigned char> storage(blob.size() + 32);
+        unsigned char* data = storage.data() + (16 - reinterpret_cast<std::uintptr_t>(storage.data()) % 16) % 16;
+        std::memcpy(data, blob.data(), blob.size());
+
+        std::size_t bytes = blob.size();
+        const unsigned char* start = damage(data, bytes);
+        MeshBlobView view;
+        return !readMeshBlob(start, bytes, view);
+    }
+}
+
+void benchMeshBlob()
+{
+    struct Case
+    {
+        const char* name;
+        glm::ivec2 pos;
+    };
+    const Case cases[] = {
+        { "ocean", glm::ivec2(-51, 18) },
+        { "coast", glm::ivec2(-48, 0) },
+        { "hills", glm::ivec2(-15, -42) },
+    };
+
+    BiomeManager biome(1.0f, WATER_LEVEL_WORLD);
+    HeightTileCache tiles(&biome, 64);
+    FakeArenaBackend freshBackend, blobBackend;
+    MeshArena freshArena(&freshBackend, 1 << 16, 1 << 18);
+    MeshArena blobArena(&blobBackend, 1 << 16, 1 << 18);
+
+    Corruption corruptions[] = { { "payload byte" }, { "index count" }, { "version" }, { "truncated" }, { "misaligned" } };
+    std::size_t meshes = 0, mismatches = 0;
+    char label[64], extra[96];
+
+    for (const Case& c : cases)
+        for (int lod = 0; lod < LOD_LEVELS; ++lod)
+        {
+            // Neighbouring chunks so each case covers a few meshes per LOD
+            for (int k = 0; k < 4; ++k)
+            {
+                glm::ivec2 pos = c.pos + glm::ivec2(k % 2, k / 2);
+                Chunk chunk(pos, &biome, &tiles, lod);
+                std::vector<PackedVertex> vertices;
+                std::vector<unsigned int> indices;
+                chunk.generateData(vertices, indices);
+                Chunk::MeshInfo info = chunk.meshInfo();
+
+                std::vector<unsigned char> blob;
+                serializeMeshBlob(info, vertices, indices, blob);
+
+                MeshBlobView view;
+                bool same = readMeshBlob(blob.data(), blob.size(), view)
+                    && view.vertexCount() == vertices.size() && view.indexCount() == indices.size()
+                    && std::memcmp(&view.header->info, &info, sizeof(info)) == 0
+                    && std::memcmp(view.vertices, vertices.data(), vertices.size() * sizeof(PackedVertex)) == 0
+                    && std::memcmp(view.indices, indices.data(), indices.size() * sizeof(unsigned int)) == 0;
+
+                if (same)
+                {
+                    glm::vec3 origin = chunk.origin();
+                    freshArena.allocate(vertices, indices, origin);
+                    blobArena.allocate(view.vertices, view.vertexCount(), view.indices, view.indexCount(), origin);
+                }
+                mismatches += !same;
+                meshes++;
+
+                if (!same || indices.empty())
+                    continue;
+
+                // Every kind of damage, on every non-empty mesh
+                const MeshBlobHeader& h = *view.header;
+                int i = 0;
+                corruptions[i].tried++;
+                corruptions[i++].rejected += rejects(blob, [&](unsigned char* d, std::size_t&) {
+                    d[h.indexOffset + (indices.size() * sizeof(unsigned int)) / 2] ^= 0x10; return d; });
+                corruptions[i].tried++;
+                corruptions[i++].rejected += rejects(blob, [&](unsigned char* d, std::size_t&) {
+                    reinterpret_cast<MeshBlobHeader*>(d)->indexCount -= 3; return d; });
+                corruptions[i].tried++;
+                corruptions[i++].rejected += rejects(blob, [&](unsigned char* d, std::size_t&) {
+                    reinterpret_cast<MeshBlobHeader*>(d)->version++; return d; });
+                corruptions[i].tried++;
+                corruptions[i++].rejected += rejects(blob, [&](unsigned char* d, std::size_t& bytes) {
+                    bytes -= sizeof(unsigned int); return d; });
+                corruptions[i].tried++;
+                corruptions[i++].rejected += rejects(blob, [&](unsigned char* d, std::size_t& bytes) {
+                    std::memmove(d + 4, d, bytes); return d + 4; });
+            }
+        }
+
+    // The arenas saw the same uploads in the same order, so their buffers must be identical
+    bool sameGpu = freshBackend.buffers == blobBackend.buffers && !freshBackend.outOfBounds && !blobBackend.outOfBounds;
+
+    // Throughput on one LOD 0 mesh per case
+    for (const Case& c : cases)
+    {
+        Chunk chunk(c.pos, &biome, &tiles, 0);
+        std::vector<PackedVertex> vertices;
+        std::vector<unsigned int> indices;
+        chunk.generateData(vertices, indices);
+        Chunk::MeshInfo info = chunk.meshInfo();
+        std::vector<unsigned char> blob;
+
+        double serializeNs = nsPerOp([&]() { serializeMeshBlob(info, vertices, indices, blob); }, 2000);
+        double readNs = nsPerOp([&]() {
+            MeshBlobView view;
+            benchSink = benchSink + double(readMeshBlob(blob.data(), blob.size(), view));
+        }, 2000);
+
+        double megabytes = double(blob.size()) / (1 << 20);
+        std::snprintf(label, sizeof(label), "%s serialize (%zu bytes)", c.name, blob.size());
+        std::snprintf(extra, sizeof(extra), "%.0f MB/s", megabytes / (serializeNs * 1e-9));
+        reportRow(label, serializeNs, extra);
+        std::snprintf(label, sizeof(label), "%s validate in place", c.name);
+        std::snprintf(extra, sizeof(extra), "%.0f MB/s", megabytes / (readNs * 1e-9));
+        reportRow(label, readNs, extra);
+    }
+
+    bool allRejected = true;
+    for (const Corruption& c : corruptions)
+    {
+        std::printf("  damaged %-14s %zu/%zu rejected\n", c.name, c.rejected, c.tried);
+        allRejected &= c.rejected == c.tried;
+    }
+    std::printf("  round trip: %zu meshes, %zu mismatches; blob uploads %s fresh uploads\n",
+        meshes, mismatches, sameGpu ? "identical to" : "DIFFER from");
+    bool roundTrip = benchCheck(mismatches == 0 && sameGpu, "blobs do not round-trip to the same meshes and uploads");
+    bool validated = benchCheck(allRejected, "readMeshBlob accepted a damaged blob");
+    if (roundTrip && validated)
+        std::printf("  blobs round-trip exactly, damage detected\n");
+}
@@ -0,0 +1,90 @@
+#include "Bench.h"
+#include "../include/Chunk.h"
+#include "../include/NoiseBatch.h"
+#include <FastNoiseLite.h>
+#include <cmath>
+#include <vector>
+
+/* ------------------------- */
+/* Batched noise benchmark */
+/* FastNoiseLite vs simplex2Batch at every SIMD level, and the */
+/* per-column BiomeManager::sample loop vs sampleGrid for one chunk */
+/* ------------------------- */
+void benchNoiseBatch()
+{
+    const int count = (CHUNK_SIZE + 3) * (CHUNK_SIZE + 3);
+    const int iterations = 200;
+    char extra[96];
+
+    Simplex2Params params;
+    params.frequency = 0.001f;
+
+    FastNoiseLite noise;
+    noise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
+    noise.SetFrequency(params.frequency);
+
+    std::vector<float> x(count), y(count), ref(count), out(count);
+    for (int i = 0; i < count; ++i)
+    {
+        x[i] = float((i / (CHUNK_SIZE + 3) - 700) * VOXEL_SIZE);
+        y[i] = float((i % (CHUNK_SIZE + 3) + 300) * VOXEL_SIZE);
+    }
+
+    double ns = nsPerOp([&]
+        {
+            for (int i = 0; i < count; ++i)
+                ref[i] = noise.GetNoise(x[i], y[i]);
+            benchSink = benchSink + ref[0];
+        }, iterations);
+    std::snprintf(extra, sizeof(extra), "%.2f ns/point", ns / count);
+    reportRow("FastNoiseLite::GetNoise x1225", ns, extra);
+
+    std::printf("  detected SIMD level: %s\n", simdLevelName(detectSimdLevel()));
+    for (SimdLevel level : { SimdLevel::Scalar, SimdLevel::SSE41, SimdLevel::AVX2 })
+    {
+        if (level > detectSimdLevel())
+            continue;
+
+        ns = nsPerOp([&]
+            {
+                simplex2BatchLevel(level, params, x.data(), y.data(), out.data(), count);
+                benchSink = benchSink + out[0];
+            }, iterations);
+
+        float maxDiff = 0.0f;
+        for (int i = 0; i < count; ++i)
+            maxDiff = std::fmax(maxDiff, std::fabs(out[i] - ref[i]));
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "simplex2Batch %s x1225", simdLevelName(level));
+        std::snprintf(extra, sizeof(extra), "%.2f ns/point, max |diff| %g", ns / count, maxDiff);
+        reportRow(name, ns, extra);
+    }
+
+    // Whole-chunk column table, as Chunk::sampleColumns fills it
+    BiomeManager biome(1.0f, WATER_LEVEL_WORLD);
+    std::vector<BiomeSample> columns(count), gridColumns(count);
+    const glm::vec2 origin(-1.0f * VOXEL_SIZE, -1.0f * VOXEL_SIZE);
+
+    ns = nsPerOp([&]
+        {
+            for (int cx = 0; cx < CHUNK_SIZE + 3; ++cx)
+                for (int cz = 0; cz < CHUNK_SIZE + 3; ++cz)
+                    columns[cx * (CHUNK_SIZE + 3) + cz] = biome.sample(
+                        origin.x + cx * VOXEL_SIZE, origin.y + cz * VOXEL_SIZE);
+            benchSink = benchSink + columns[0].height;
+        }, iterations);
+    reportRow("BiomeManager::sample per column", ns);
+
+    ns = nsPerOp([&]
+        {
+            biome.sampleGrid(origin, float(VOXEL_SIZE), CHUNK_SIZE + 3, CHUNK_SIZE + 3, gridColumns.data());
+            benchSink = benchSink + gridColumns[0].height;
+        }, iterations);
+
+    float maxDiff = 0.0f;
+    for (int i = 0; i < count; ++i)
+        maxDiff = std::fmax(maxDiff, std::fabs(gridColumns[i].height - columns[i].height));
+    std::snprintf(extra, sizeof(extra), "max |height diff| %g", maxDiff);
+    reportRow("BiomeManager::sampleGrid 35x35", ns, extra);
+}
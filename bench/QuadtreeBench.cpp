@@ -0,0 +1,134 @@
+#include "Bench.h"
+#include "../include/Chunk.h"
+#include "../include/ChunkQuadtree.h"
+#include "../include/FrustumCuller.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+struct BenchVec2Hash
+{
+    std::size_t operator()(const glm::ivec2& v) const
+    {
+        return std::hash<int>()(v.x) ^ (std::hash<int>()(v.y) << 1);
+    }
+};
+
+/* ------------------------- */
+/* Chunk quadtree benchmark */
+/* A full load window at radius 8/24/32/64: hierarchical vs flat SIMD */
+/* frustum culling, and the unload scan after a one-chunk camera move */
+/* done over the whole chunk map vs as a quadtree window query */
+/* ------------------------- */
+static void runWindow(int radius)
+{
+    const float chunkWorld = float(CHUNK_SIZE * VOXEL_SIZE);
+    const float fullHeight = float(CHUNK_HEIGHT * VOXEL_SIZE);
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> ground(0.35f * fullHeight, 0.55f * fullHeight);
+    std::uniform_real_distribution<float> relief(4.0f, 40.0f);
+
+    // The window is centred away from the origin so it spans several tiles
+    glm::ivec2 center(1000, -700);
+    ChunkQuadtree tree(chunkWorld);
+    FrustumCuller flat;
+    std::unordered_map<glm::ivec2, std::uint32_t, BenchVec2Hash> chunks;
+
+    std::vector<glm::vec2> heights;
+    for (int z = -radius; z <= radius; ++z)
+    {
+        for (int x = -radius; x <= radius; ++x)
+        {
+            float lo = ground(rng);
+            heights.push_back(glm::vec2(lo, lo + relief(rng)));
+        }
+    }
+
+    auto insertStart = std::chrono::steady_clock::now();
+    for (int z = -radius, i = 0; z <= radius; ++z)
+    {
+        for (int x = -radius; x <= radius; ++x, ++i)
+        {
+            glm::ivec2 pos = center + glm::ivec2(x, z);
+            tree.insert(pos, std::uint32_t(i + 1), heights[i].x, heights[i].y);
+        }
+    }
+    double insertNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - insertStart).count() / heights.size();
+
+    for (int z = -radius, i = 0; z <= radius; ++z)
+    {
+        for (int x = -radius; x <= radius; ++x, ++i)
+        {
+            glm::ivec2 pos = center + glm::ivec2(x, z);
+            glm::vec3 corner(pos.x * chunkWorld, heights[i].x, pos.y * chunkWorld);
+            flat.set(std::uint32_t(i + 1), corner, glm::vec3(corner.x + chunkWorld, heights[i].y, corner.z + chunkWorld));
+            chunks[pos] = std::uint32_t(i + 1);
+        }
+    }
+
+    glm::vec3 eye((center.x + 0.5f) * chunkWorld, 0.6f * fullHeight, (center.y + 0.5f) * chunkWorld);
+    glm::mat4 proj = glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 1e6f);
+    glm::mat4 viewProj = proj * glm::lookAt(eye, eye + glm::vec3(1.0f, -0.35f, 0.4f), glm::vec3(0.0f, 1.0f, 0.0f));
+    Frustum frustum(viewProj);
+
+    const int iterations = radius >= 64 ? 100 : 1000;
+    char name[64], extra[128];
+
+    std::vector<std::uint32_t> flatVisible, treeVisible;
+    double flatNs = nsPerOp([&] { flat.cull(frustum, flatVisible); benchSink = benchSink + flatVisible.size(); }, iterations);
+    double treeNs = nsPerOp([&] { tree.cull(frustum, treeVisible); benchSink = benchSink + treeVisible.size(); }, iterations);
+    std::sort(flatVisible.begin(), flatVisible.end());
+    std::sort(treeVisible.begin(), treeVisible.end());
+
+    std::printf("  radius %d: %zu chunks, %zu tree nodes, insert %.0f ns/chunk\n",
+        radius, chunks.size(), tree.nodeCount(), insertNs);
+    std::snprintf(name, sizeof(name), "cull flat SIMD");
+    std::snprintf(extra, sizeof(extra), "%zu visible", flatVisible.size());
+    reportRow(name, flatNs, extra);
+    std::snprintf(name, sizeof(name), "cull quadtree");
+    std::snprintf(extra, sizeof(extra), "%zu visible, %s", treeVisible.size(), treeVisible == flatVisible ? "same set" : "MISMATCH");
+    reportRow(name, treeNs, extra);
+
+    // Unload scan after the camera moved one chunk (+x): the -x column leaves
+    glm::ivec2 moved = center + glm::ivec2(1, 0);
+    std::vector<glm::ivec2> linearOut, treeOut;
+    double linearNs = nsPerOp([&]
+        {
+            linearOut.clear();
+            for (const auto& entry : chunks)
+            {
+                glm::ivec2 pos = entry.first;
+                if (std::max(std::abs(pos.x - moved.x), std::abs(pos.y - moved.y)) > radius)
+                    linearOut.push_back(pos);
+            }
+        }, iterations);
+    double queryNs = nsPerOp([&]
+        {
+            treeOut.clear();
+            tree.collectOutside(moved, radius, treeOut);
+        }, iterations);
+
+    std::snprintf(extra, sizeof(extra), "%zu to unload", linearOut.size());
+    reportRow("unload scan over chunk map", linearNs, extra);
+    std::snprintf(extra, sizeof(extra), "%zu to unload, %s", treeOut.size(), treeOut.size() == linearOut.size() ? "same count" : "MISMATCH");
+    reportRow("unload query on quadtree", queryNs, extra);
+
+    // Removing the whole window must leave an empty tree
+    auto removeStart = std::chrono::steady_clock::now();
+    for (const auto& entry : chunks)
+        tree.remove(entry.first);
+    double removeNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - removeStart).count() / chunks.size();
+    std::printf("  remove %.0f ns/chunk, %zu chunks and %zu nodes left\n", removeNs, tree.size(), tree.nodeCount());
+}
+
+void benchChunkQuadtree()
+{
+    runWindow(8);
+    runWindow(24);   // World's LOAD_RADIUS
+    runWindow(32);
+    runWindow(64);
+}
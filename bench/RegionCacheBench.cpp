@@ -0,0 +1,203 @@
+#include "Bench.h"
+#include "FakeArenaBackend.h"
+#include "../include/Chunk.h"
+#include "../include/HeightTileCache.h"
+#include "../include/RegionCache.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_set>
+#include <vector>
+
+/* ------------------------- */
+/* Region cache benchmark */
+/* Flies a fixed path through World's LOD window twice: cold (empty */
+/* cache: generate, store, upload) and warm (a new cache over the same */
+/* files: map, upload). Uploads go to a fake GPU in both, so the */
+/* difference is generation against reading the mapped records. */
+/* The warm meshes must match the cold ones byte for byte, and a cache */
+/* opened with another generator key must treat every file as stale */
+/* ------------------------- */
+
+namespace
+{
+    // World's window and LOD bands
+    const int FLIGHT_LOD_RADIUS[LOD_LEVELS - 1] = { 4, 8, 16 };
+    const int FLIGHT_RADIUS = 24;
+
+    // Ocean to coast to land along +x, one chunk per step
+    const glm::ivec2 FLIGHT_START(-72, 0);
+    const int FLIGHT_STEPS = 32;
+
+    const char* CACHE_DIR = "bench_region_cache";
+
+    struct Request
+    {
+        glm::ivec2 pos;
+        int lod;
+    };
+
+    int flightLod(int distance)
+    {
+        int lod = 0;
+        while (lod < LOD_LEVELS - 1 && distance > FLIGHT_LOD_RADIUS[lod])
+            ++lod;
+        return lod;
+    }
+
+    // Every (chunk, LOD) the flight needs, in the order it first needs them
+    std::vector<Request> flightRequests()
+    {
+        std::vector<Request> requests;
+        std::unordered_set<std::uint64_t> seen;
+        for (int step = 0; step <= FLIGHT_STEPS; ++step)
+        {
+            glm::ivec2 center = FLIGHT_START + glm::ivec2(step, 0);
+            for (int x = -FLIGHT_RADIUS; x <= FLIGHT_RADIUS; ++x)
+                for (int z = -FLIGHT_RADIUS; z <= FLIGHT_RADIUS; ++z)
+                {
+                    Request r = { center + glm::ivec2(x, z), flightLod(std::max(std::abs(x), std::abs(z))) };
+                    std::uint64_t key = (std::uint64_t(std::uint32_t(r.pos.x)) << 34)
+                        ^ (std::uint64_t(std::uint32_t(r.pos.y)) << 2) ^ std::uint64_t(r.lod);
+                    if (seen.insert(key).second)
+                        requests.push_back(r);
+                }
+        }
+        return requests;
+    }
+
+    void removeRegionFiles(const std::vector<Request>& requests)
+    {
+        std::unordered_set<std::uint64_t> removed;
+        for (const Request& r : requests)
+        {
+            glm::ivec2 region = RegionCache::regionOf(r.pos);
+            if (removed.insert((std::uint64_t(std::uint32_t(region.x)) << 32) | std::uint32_t(region.y)).second)
+                std::remove(RegionCache::regionPath(CACHE_DIR, region).c_str());
+        }
+    }
+
+    struct FlightResult
+    {
+        double seconds = 0.0;
+        std::size_t generated = 0, loaded = 0;
+        std::uint64_t triangles = 0;
+        std::uint64_t meshHash = 0xCBF29CE484222325ull;   // Over every vertex and index, in order
+    };
+
+    // Builds every request the way World's workers do, cache first
+    FlightResult fly(const std::vector<Request>& requests, const BiomeManager& biome, RegionCache& cache)
+    {
+        HeightTileCache tiles(&biome, 1024);
+        FakeArenaBackend backend;
+        MeshArena arena(&backend, 1 << 18, 1 << 20);
+        std::vector<PackedVertex> vertices;
+        std::vector<unsigned int> indices;
+        std::vector<std::uint64_t> hashes(requests.size());
+        FlightResult result;
+
+        double nanoseconds = 0.0;
+        for (std::size_t i = 0; i < requests.size(); ++i)
+        {
+            const Request& r = requests[i];
+            auto start = std::chrono::steady_clock::now();
+            Chunk chunk(r.pos, &biome, &tiles, r.lod);
+            CachedMesh cached;
+
+            const PackedVertex* v;
+            const unsigned int* idx;
+            std::size_t vertexCount, indexCount;
+            if (cache.load(r.pos, r.lod, cached))
+            {
+                chunk.restoreMesh(cached.info());
+                v = cached.vertices();
+                idx = cached.indices();
+                vertexCount = cached.vertexCount();
+                indexCount = cached.indexCount();
+                result.loaded++;
+            }
+            else
+            {
+                chunk.generateData(vertices, indices);
+                cache.store(r.pos, r.lod, chunk.meshInfo(), vertices, indices);
+                v = vertices.data();
+                idx = indices.data();
+                vertexCount = vertices.size();
+                indexCount = indices.size();
+                result.generated++;
+            }
+
+            chunk.finalize(&arena, v, vertexCount, idx, indexCount);
+            nanoseconds += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            result.triangles += indexCount / 3;
+
+            // Not timed: byte-wise hashing costs as much as a warm load
+            std::uint64_t h = 0xCBF29CE484222325ull;
+            hashBytes(h, v, vertexCount * sizeof(PackedVertex));
+            hashBytes(h, idx, indexCount * sizeof(unsigned int));
+            hashes[i] = h;
+        }
+        result.seconds = nanoseconds * 1e-9;
+
+        for (std::uint64_t h : hashes)
+            hashBytes(result.meshHash, &h, sizeof(h));
+        return result;
+    }
+}
+
+void benchRegionCache()
+{
+    BiomeManager biome(1.0f, WATER_LEVEL_WORLD);
+    std::vector<Request> requests = flightRequests();
+    removeRegionFiles(requests);
+
+    FlightResult cold, warm;
+    RegionCache::Stats written, read;
+    {
+        RegionCache cache(CACHE_DIR, biome.generatorKey());
+        cold = fly(requests, biome, cache);
+        written = cache.stats();
+    }
+    {
+        // A new cache instance: nothing carried over but the files
+        RegionCache cache(CACHE_DIR, biome.generatorKey());
+        warm = fly(requests, biome, cache);
+        read = cache.stats();
+    }
+
+    std::size_t n = requests.size();
+    char extra[128];
+    std::printf("  flythrough: %d steps from chunk (%d,%d), %zu chunk meshes over all LODs\n",
+        FLIGHT_STEPS, FLIGHT_START.x, FLIGHT_START.y, n);
+
+    std::snprintf(extra, sizeof(extra), "%.0f ms total, %zu generated, %.1f MB written",
+        cold.seconds * 1e3, cold.generated, double(written.bytesWritten) / (1 << 20));
+    reportRow("cold: generate + store + upload", cold.seconds * 1e9 / n, extra);
+
+    std::snprintf(extra, sizeof(extra), "%.0f ms total, %llu/%zu hits, %.1fx faster",
+        warm.seconds * 1e3, (unsigned long long)read.hits, n, cold.seconds / warm.seconds);
+    reportRow("warm: map + upload", warm.seconds * 1e9 / n, extra);
+    std::printf("  (warm reads pages the OS still caches, as on the next run of a session)\n");
+
+    // Any other generator key must not see these records
+    std::size_t staleHits = 0;
+    std::uint64_t staleRegions = 0;
+    {
+        RegionCache other(CACHE_DIR, biome.generatorKey() ^ 1);
+        CachedMesh cached;
+        for (const Request& r : requests)
+            staleHits += other.load(r.pos, r.lod, cached);
+        staleRegions = other.stats().staleRegions;
+    }
+    removeRegionFiles(requests);
+
+    bool identical = warm.loaded == n && warm.meshHash == cold.meshHash && warm.triangles == cold.triangles;
+    std::printf("  other generator key: %zu hits, %llu regions reset as stale\n",
+        staleHits, (unsigned long long)staleRegions);
+    bool warmOk = benchCheck(identical, "warm meshes differ from cold or were not all served from the cache");
+    bool staleOk = benchCheck(staleHits == 0, "a cache under another generator key served stale meshes");
+    if (warmOk && staleOk)
+        std::printf("  warm meshes identical to cold, stale data rejected\n");
+    benchSink = benchSink + double(warm.triangles);
+}
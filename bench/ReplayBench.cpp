@@ -0,0 +1,279 @@
+#include "Bench.h"
+#include "SimClock.h"
+#include "../include/CameraPath.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* ------------------------- */
+/* Camera path replay */
+/* Feeds a camera path (recorded with ProceduralTerrain --record-path, */
+/* or the scripted one below) into a headless World at the path's tick */
+/* rate, on the SimClock of the "world" bench, and writes JSON meant */
+/* to be diffed between builds: load-to-upload and load-to-draw latency */
+/* percentiles, frames with holes, and per-frame update and draw cost. */
+/* Latencies and holes are in simulated time and reproduce exactly; */
+/* only the CPU costs vary from run to run. The simulated clock charges */
+/* a fixed cost per generated chunk, so a change in how many chunks are */
+/* generated shows in the latencies but a faster generator does not; */
+/* --clock=real replays in wall-clock time instead (ticks paced by */
+/* sleeping, workers not waited for) to measure actual generation, at */
+/* the cost of reproducibility */
+/* Options: --path=FILE replays a recorded path, --json=FILE (default */
+/* replay.json) is where the report goes, --clock=sim|real */
+/* ------------------------- */
+
+namespace
+{
+    const float CHUNK_WORLD = float(CHUNK_SIZE * VOXEL_SIZE);
+
+    /* ------------------------- */
+    /* 20 s from the ocean inland: cruise at 2 chunks/s, look all the way */
+    /* round while cruising, dash at 8 chunks/s (faster than streaming */
+    /* keeps up), then stop, turn to +z and climb */
+    /* ------------------------- */
+    CameraPath scriptedPath()
+    {
+        CameraPath path;
+        glm::vec3 position(-72.0f * CHUNK_WORLD, 300.0f, 0.5f * CHUNK_WORLD);
+        const int ticks = 20 * CAMERA_PATH_TICK_HZ;
+
+        for (int tick = 0; tick < ticks; ++tick)
+        {
+            float t = float(tick * path.tickSeconds());
+            CameraKey key;
+            key.position = position;
+            key.yaw = 0.0f;
+            key.pitch = -17.0f;
+
+            glm::vec3 velocity(2.0f * CHUNK_WORLD, 0.0f, 0.0f);
+            if (t >= 6.0f && t < 10.0f)
+                key.yaw = 90.0f * (t - 6.0f);
+            else if (t >= 10.0f && t < 15.0f)
+                velocity.x = 8.0f * CHUNK_WORLD;
+            else if (t >= 15.0f)
+            {
+                velocity = glm::vec3(0.0f, 60.0f, 0.0f);
+                key.yaw = std::min(t - 15.0f, 1.0f) * 90.0f;
+            }
+
+            path.add(key);
+            position += velocity * float(path.tickSeconds());
+        }
+        return path;
+    }
+
+    struct ReplayFrame
+    {
+        double updateUs, drawUs;        // CPU time; not reproducible
+        std::uint32_t holes;
+        std::uint32_t uploads;          // Chunks uploaded for the first time
+        std::uint32_t firstDraws;       // Chunks drawn for the first time
+    };
+
+    struct ReplayResult
+    {
+        std::vector<ReplayFrame> frames;
+        std::vector<double> uploadLatency, drawLatency;   // Seconds, one per chunk
+        StreamingStats streaming;
+        RecordingArenaBackend::Counters gpu;
+    };
+
+    ReplayResult replay(const CameraPath& path, int workers, bool realClock)
+    {
+        RecordingArenaBackend backend;
+        SimClock clock(backend, workers);
+        auto replayStart = std::chrono::steady_clock::now();
+
+        WorldConfig config;
+        config.backend = &backend;
+        if (!realClock)
+            config.clock = clock.function();
+        config.regionCacheDir = "";
+        config.workerThreads = workers;
+        config.latencyProbe = true;
+
+        ReplayResult result;
+        result.frames.reserve(path.size());
+        {
+            World world(config);
+            glm::mat4 projection = glm::perspective(glm::radians(90.0f), 800.0f / 600.0f, 0.1f, 10000.0f);
+
+            for (std::size_t tick = 0; tick < path.size(); ++tick)
+            {
+                double frameTime = double(tick) * path.tickSeconds();
+                glm::mat4 viewProj = projection * CameraPath::viewMatrix(path[tick]);
+
+                if (realClock)
+                    std::this_thread::sleep_until(replayStart + std::chrono::duration<double>(frameTime));
+                else
+                {
+                    world.waitForWorkers();
+                    clock.startFrame(frameTime, world);
+                }
+                auto start = std::chrono::steady_clock::now();
+                world.update(path[tick].position);
+                auto updated = std::chrono::steady_clock::now();
+                world.submitDraws(viewProj);
+                auto drawn = std::chrono::steady_clock::now();
+
+                const StreamingProbe& probe = world.streamingProbe();
+                ReplayFrame frame;
+                frame.updateUs = std::chrono::duration<double, std::micro>(updated - start).count();
+                frame.drawUs = std::chrono::duration<double, std::micro>(drawn - updated).count();
+                frame.holes = probe.holes;
+                frame.uploads = std::uint32_t(probe.uploadLatency.size());
+                frame.firstDraws = std::uint32_t(probe.drawLatency.size());
+                result.frames.push_back(frame);
+                result.uploadLatency.insert(result.uploadLatency.end(), probe.uploadLatency.begin(), probe.uploadLatency.end());
+                result.drawLatency.insert(result.drawLatency.end(), probe.drawLatency.begin(), probe.drawLatency.end());
+            }
+
+            world.waitForWorkers();
+            result.streaming = world.streamingStats();
+        }
+        result.gpu = backend.counters();
+        return result;
+    }
+
+    // Nearest-rank percentile of sorted values (0 when there are none)
+    double percentile(const std::vector<double>& sorted, double p)
+    {
+        if (sorted.empty())
+            return 0.0;
+        std::size_t rank = std::size_t(std::ceil(p * double(sorted.size())));
+        return sorted[std::min(std::max(rank, std::size_t(1)), sorted.size()) - 1];
+    }
+
+    // {"count", "mean", "p50", "p95", "p99", "max"} of values times scale
+    void writeDistribution(FILE* out, const char* name, std::vector<double> values, double scale, bool last = false)
+    {
+        std::sort(values.begin(), values.end());
+        double sum = 0.0;
+        for (double v : values)
+            sum += v;
+        double mean = values.empty() ? 0.0 : sum / double(values.size());
+
+        std::fprintf(out, "  \"%s\": {\"count\": %zu, \"mean\": %.3f, \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f}%s\n",
+            name, values.size(), mean * scale, percentile(values, 0.50) * scale, percentile(values, 0.95) * scale,
+            percentile(values, 0.99) * scale, (values.empty() ? 0.0 : values.back()) * scale, last ? "" : ",");
+    }
+
+    // Path names go into a JSON string; only quotes and backslashes need escaping
+    std::string jsonEscape(const std::string& text)
+    {
+        std::string escaped;
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+}
+
+void benchReplay()
+{
+    const int workers = 4;
+    std::string pathFile = benchOption("path", "");
+    std::string jsonFile = benchOption("json", "replay.json");
+    bool realClock = std::string(benchOption("clock", "sim")) == "real";
+
+    CameraPath path;
+    if (pathFile.empty())
+        path = scriptedPath();
+    else if (!path.load(pathFile) || path.empty())
+    {
+        std::printf("  FAILED: cannot read camera path %s\n", pathFile.c_str());
+        return;
+    }
+
+    ReplayResult result = replay(path, workers, realClock);
+
+    std::uint64_t holeFrames = 0, holeChunkFrames = 0;
+    std::uint32_t worstHoles = 0;
+    std::size_t lastHoleFrame = 0;
+    std::vector<double> updateUs, drawUs;
+    for (std::size_t i = 0; i < result.frames.size(); ++i)
+    {
+        const ReplayFrame& f = result.frames[i];
+        if (f.holes > 0)
+        {
+            holeFrames++;
+            lastHoleFrame = i;
+        }
+        holeChunkFrames += f.holes;
+        worstHoles = std::max(worstHoles, f.holes);
+        updateUs.push_back(f.updateUs);
+        drawUs.push_back(f.drawUs);
+    }
+
+    FILE* out = std::fopen(jsonFile.c_str(), "w");
+    if (!out)
+    {
+        std::printf("  FAILED: cannot write %s\n", jsonFile.c_str());
+        return;
+    }
+
+    // Reproducible fields first (on the simulated clock); the CPU costs at the end differ between runs
+    std::fprintf(out, "{\n");
+    std::fprintf(out, "  \"path\": \"%s\",\n", pathFile.empty() ? "scripted" : jsonEscape(pathFile).c_str());
+    std::fprintf(out, "  \"clock\": \"%s\",\n", realClock ? "real" : "sim");
+    std::fprintf(out, "  \"ticks\": %zu,\n  \"tick_hz\": %.17g,\n  \"workers\": %d,\n  \"seed\": %d,\n",
+        path.size(), path.tickRate(), workers, DEFAULT_TERRAIN_SEED);
+    writeDistribution(out, "load_to_upload_ms", result.uploadLatency, 1e3);
+    writeDistribution(out, "load_to_draw_ms", result.drawLatency, 1e3);
+    std::fprintf(out, "  \"holes\": {\"frames\": %llu, \"chunk_frames\": %llu, \"worst_frame\": %u, \"last_frame\": %zu},\n",
+        (unsigned long long)holeFrames, (unsigned long long)holeChunkFrames, worstHoles, lastHoleFrame);
+    std::fprintf(out, "  \"streaming\": {\"generated\": %llu, \"wasted\": %llu, \"cancelled\": %llu},\n",
+        (unsigned long long)result.streaming.generated, (unsigned long long)result.streaming.wasted,
+        (unsigned long long)result.streaming.cancelled);
+    std::fprintf(out, "  \"gpu\": {\"uploads\": %llu, \"bytes_uploaded\": %llu, \"draw_calls\": %llu, \"triangles_drawn\": %llu, \"errors\": %llu},\n",
+        (unsigned long long)result.gpu.uploads, (unsigned long long)result.gpu.bytesUploaded,
+        (unsigned long long)result.gpu.drawCalls, (unsigned long long)result.gpu.trianglesDrawn,
+        (unsigned long long)result.gpu.errors);
+    writeDistribution(out, "update_us", updateUs, 1.0);
+    writeDistribution(out, "draw_us", drawUs, 1.0);
+
+    // One line per frame: [update us, draw us, holes, uploads, first draws]
+    std::fprintf(out, "  \"frames\": [\n");
+    for (std::size_t i = 0; i < result.frames.size(); ++i)
+    {
+        const ReplayFrame& f = result.frames[i];
+        std::fprintf(out, "    [%.1f, %.1f, %u, %u, %u]%s\n", f.updateUs, f.drawUs, f.holes, f.uploads, f.firstDraws,
+            i + 1 < result.frames.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+    bool written = std::ferror(out) == 0;
+    written = std::fclose(out) == 0 && written;
+
+    std::sort(result.uploadLatency.begin(), result.uploadLatency.end());
+    std::sort(result.drawLatency.begin(), result.drawLatency.end());
+    std::sort(updateUs.begin(), updateUs.end());
+    std::sort(drawUs.begin(), drawUs.end());
+
+    std::printf("  %zu ticks at %.0f Hz (%s path, %s clock), %d workers\n", path.size(), path.tickRate(),
+        pathFile.empty() ? "scripted" : pathFile.c_str(), realClock ? "real" : "simulated", workers);
+    std::printf("  load to upload: %zu chunks, p50 %.0f ms, p95 %.0f ms, p99 %.0f ms\n", result.uploadLatency.size(),
+        percentile(result.uploadLatency, 0.50) * 1e3, percentile(result.uploadLatency, 0.95) * 1e3,
+        percentile(result.uploadLatency, 0.99) * 1e3);
+    std::printf("  load to draw:   %zu chunks, p50 %.0f ms, p95 %.0f ms, p99 %.0f ms\n", result.drawLatency.size(),
+        percentile(result.drawLatency, 0.50) * 1e3, percentile(result.drawLatency, 0.95) * 1e3,
+        percentile(result.drawLatency, 0.99) * 1e3);
+    std::printf("  holes: %llu of %zu frames (worst %u chunks, last in frame %zu)\n",
+        (unsigned long long)holeFrames, result.frames.size(), worstHoles, lastHoleFrame);
+
+    char extra[96];
+    std::snprintf(extra, sizeof(extra), "p99 %.0f us", percentile(updateUs, 0.99));
+    reportRow("World::update per frame", percentile(updateUs, 0.50) * 1e3, extra);
+    std::snprintf(extra, sizeof(extra), "p99 %.0f us", percentile(drawUs, 0.99));
+    reportRow("World::submitDraws per frame", percentile(drawUs, 0.50) * 1e3, extra);
+
+    std::printf("  %s %s\n", written ? "wrote" : "FAILED: could not write", jsonFile.c_str());
+    benchSink = benchSink + double(result.gpu.trianglesDrawn);
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include "../include/RecordingArenaBackend.h"
+#include "../include/World.h"
+#include <cstdint>
+#include <functional>
+
+/* ------------------------- */
+/* Simulated clock for headless World benches (WorldConfig::clock) */
+/* Time is the frame's start, plus the GPU traffic so far at 1 us per */
+/* KB (UploadBudget's starting guess), plus the chunks generated so far */
+/* at the measured generateData cost, shared between the workers. */
+/* Generation is charged at frame boundaries only (startFrame, after */
+/* World::waitForWorkers), so every read within a frame is reproducible */
+/* however the workers interleave */
+/* ------------------------- */
+class SimClock
+{
+public:
+    static constexpr double UPLOAD_SECONDS_PER_BYTE = 1e-6 / 1024.0;
+    static constexpr double GENERATE_SECONDS_PER_CHUNK = 0.5e-3;   // "hotpaths" generateData, 0.43-0.64 ms
+
+    SimClock(const RecordingArenaBackend& backend, int workers)
+        : backend(backend), workers(workers)
+    {
+    }
+
+    // Call once per frame, after waitForWorkers and before update
+    void startFrame(double seconds, World& world)
+    {
+        frameTime = seconds;
+        generated = world.streamingStats().generated;
+    }
+
+    double now() const
+    {
+        const RecordingArenaBackend::Counters& c = backend.counters();
+        return frameTime
+            + double(c.bytesUploaded + c.bytesCopied) * UPLOAD_SECONDS_PER_BYTE
+            + double(generated) * GENERATE_SECONDS_PER_CHUNK / workers;
+    }
+
+    std::function<double()> function() const
+    {
+        return [this] { return now(); };
+    }
+
+private:
+    const RecordingArenaBackend& backend;
+    int workers;
+    double frameTime = 0.0;
+    std::uint64_t generated = 0;
+};
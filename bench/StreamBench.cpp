@@ -0,0 +1,138 @@
+#include "Bench.h"
+#include "SimClock.h"
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+/* ------------------------- */
+/* Streaming update benchmark */
+/* A headless World walks a fixed chunk path, one chunk crossing per */
+/* streaming update: straight, diagonal, then back. Before each crossing */
+/* the workers finish and every built chunk is finalized, and World */
+/* hands the jobs to the workers only after its scans, so the time read */
+/* back (World::lastScanSeconds) is the queue, unload and LOD passes */
+/* alone. Each load radius runs twice, rescanning the whole window vs */
+/* only the strips the move changed: the rescan grows with r^2, the ring */
+/* diff with r. Both modes must end with the same chunks loaded */
+/* ------------------------- */
+
+namespace
+{
+    const int RADII[] = { 8, 32, 128 };
+    const int UNLOAD_MARGIN = UNLOAD_RADIUS - LOAD_RADIUS;   // World's default gap
+    const int LEG = 10;                 // Crossings per leg of the path
+    const int STEPS = 3 * LEG;
+    const double STEP_SECONDS = 0.25;   // Past World's 5 Hz update limit
+    const float CHUNK_WORLD = float(CHUNK_SIZE * VOXEL_SIZE);
+
+    // Camera chunk after each step of the path
+    glm::ivec2 pathStep(int step)
+    {
+        if (step < LEG) return glm::ivec2(step, 0);
+        if (step < 2 * LEG) return glm::ivec2(step, step - LEG);
+        return glm::ivec2(2 * LEG - (step - 2 * LEG), LEG);
+    }
+
+    glm::vec3 chunkCenter(glm::ivec2 chunk)
+    {
+        return glm::vec3((chunk.x + 0.5f) * CHUNK_WORLD, 300.0f, (chunk.y + 0.5f) * CHUNK_WORLD);
+    }
+
+    // Run the workers dry and finalize everything they built, and any
+    // LOD rebuilds that queues, without moving the camera
+    void drain(World& world, SimClock& clock, double time, glm::ivec2 camera)
+    {
+        std::uint64_t generated;
+        do
+        {
+            generated = world.streamingStats().generated;
+            world.waitForWorkers();
+            clock.startFrame(time, world);
+            world.update(chunkCenter(camera));
+        } while (world.streamingStats().generated != generated);
+    }
+
+    // Loaded chunks as (x, z, lod), sorted
+    typedef std::tuple<int, int, int> LoadedChunk;
+
+    // Median scan time per crossing, in nanoseconds
+    double runStream(int radius, bool ringDiff, std::vector<LoadedChunk>& loaded)
+    {
+        RecordingArenaBackend backend;
+        SimClock clock(backend, 1);
+
+        WorldConfig config;
+        config.backend = &backend;
+        config.clock = clock.function();
+        config.regionCacheDir = "";
+        config.workerThreads = 1;
+        config.ringDiffStreaming = ringDiff;
+        config.loadRadius = radius;
+        config.unloadRadius = radius + UNLOAD_MARGIN;
+
+        std::vector<double> crossingNs;
+        {
+            World world(config);
+            world.finalizeBudget().setBudget(1e12);   // Drain in one frame; uploads are not timed
+            double time = 0.0;
+
+            for (int step = 0; step <= STEPS; ++step)
+            {
+                // Finish and finalize the previous step inside the rate limit window
+                drain(world, clock, time + 0.01, pathStep(std::max(step - 1, 0)));
+                if (step == STEPS)
+                    break;
+
+                time += STEP_SECONDS;
+                clock.startFrame(time, world);
+                world.update(chunkCenter(pathStep(step)));
+
+                // Step 0 loads the whole first window around the path's start
+                if (step > 0)
+                    crossingNs.push_back(world.lastScanSeconds() * 1e9);
+            }
+
+            loaded.clear();
+            for (const ChunkGrid::Entry& entry : world.chunks)
+                loaded.push_back(LoadedChunk(entry.pos.x, entry.pos.y, entry.chunk->lod()));
+            std::sort(loaded.begin(), loaded.end());
+        }
+
+        std::sort(crossingNs.begin(), crossingNs.end());
+        double median = crossingNs[crossingNs.size() / 2];
+
+        char name[64], extra[128];
+        std::snprintf(name, sizeof(name), "r = %d, %s", radius, ringDiff ? "ring diff" : "full rescan");
+        std::snprintf(extra, sizeof(extra), "median per crossing (worst %.1f us), %zu chunks loaded",
+            crossingNs.back() / 1000.0, loaded.size());
+        reportRow(name, median, extra);
+        return median;
+    }
+}
+
+void benchStreaming()
+{
+    std::printf("  %d chunk crossings per run, scans timed inside World::update\n", STEPS - 1);
+
+    const int count = int(sizeof(RADII) / sizeof(RADII[0]));
+    double fullNs[count], diffNs[count];
+    bool identical = true;
+    for (int i = 0; i < count; ++i)
+    {
+        std::vector<LoadedChunk> full, diff;
+        fullNs[i] = runStream(RADII[i], false, full);
+        diffNs[i] = runStream(RADII[i], true, diff);
+        identical = identical && full == diff;
+    }
+
+    // Growth between consecutive radii next to what r and r^2 predict
+    for (int i = 1; i < count; ++i)
+    {
+        double r = double(RADII[i]) / RADII[i - 1];
+        std::printf("  r %d -> %d: full rescan x%.1f, ring diff x%.1f (r predicts x%.0f, r^2 x%.0f)\n",
+            RADII[i - 1], RADII[i], fullNs[i] / fullNs[i - 1], diffNs[i] / diffNs[i - 1], r, r * r);
+    }
+
+    if (benchCheck(identical, "ring-diff streaming loads different chunks or LODs than a full rescan"))
+        std::printf("  loaded chunks and LODs identical at every radius\n");
+}
@@ -0,0 +1,148 @@
+#include "Bench.h"
+#include "../include/Chunk.h"
+#include "../include/VertexFormat.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // Worst round-trip errors over a set of vertices
+    struct RoundTripError
+    {
+        float position = 0.0f;   // World units, per axis
+        float color = 0.0f;      // Per channel, in [0, 1]
+        float normalDeg = 0.0f;  // Angle between the normal and its decode
+        std::size_t count = 0;
+
+        void add(const glm::vec3& p, const glm::vec3& n, const glm::vec3& c)
+        {
+            PackedVertex v = packVertex(p, n, c);
+            glm::vec3 dp = unpackPosition(v) - p;
+            glm::vec3 dc = unpackColor(v) - c;
+            position = std::max({ position, std::fabs(dp.x), std::fabs(dp.y), std::fabs(dp.z) });
+            color = std::max({ color, std::fabs(dc.x), std::fabs(dc.y), std::fabs(dc.z) });
+            float cosA = std::min(1.0f, glm::dot(unpackNormal(v), n));
+            normalDeg = std::max(normalDeg, std::acos(cosA) * 57.29578f);
+            count++;
+        }
+    };
+
+    // Quantization bounds: half a step for positions and unorm8 colours,
+    // and the worst case of best-of-four octahedral snorm8 (Cigolle et
+    // al. 2014 give 0.64 deg; slack for the float decode)
+    const float POSITION_BOUND = 0.5f / POSITION_STEPS_PER_UNIT;
+    const float COLOR_BOUND = 0.5f / 255.0f;
+    const float NORMAL_BOUND_DEG = 0.65f;
+
+    // Fails the run if any error is past its bound
+    void checkBounds(const char* set, const RoundTripError& e)
+    {
+        char what[128];
+        std::printf("  %s round trip (%zu vertices): position %.5f units (bound %.5f), normal %.3f deg (bound %.2f), colour %.5f (bound %.5f)\n",
+            set, e.count, e.position, POSITION_BOUND, e.normalDeg, NORMAL_BOUND_DEG, e.color, COLOR_BOUND);
+        std::snprintf(what, sizeof(what), "%s positions off by more than half a step", set);
+        benchCheck(e.position <= POSITION_BOUND * 1.0001f, what);
+        std::snprintf(what, sizeof(what), "%s normals off by more than the octahedral snorm8 bound", set);
+        benchCheck(e.normalDeg <= NORMAL_BOUND_DEG, what);
+        std::snprintf(what, sizeof(what), "%s colours off by more than half a step", set);
+        benchCheck(e.color <= COLOR_BOUND * 1.0001f, what);
+    }
+}
+
+/* ------------------------- */
+/* PackedVertex round trip and cost */
+/* Checks the quantization error against its bounds for random vertices */
+/* and edge inputs (chunk corners, axis and fold-seam normals, 0/1 */
+/* colours), then measures packing throughput and bytes per vertex */
+/* against the old float streams */
+/* ------------------------- */
+void benchVertexPack()
+{
+    const int count = 1 << 16;
+    char extra[128];
+
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> pos(0.0f, float(CHUNK_SIZE * VOXEL_SIZE));
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> col(0.0f, 1.0f);
+
+    std::vector<glm::vec3> p(count), n(count), c(count);
+    for (int i = 0; i < count; ++i)
+    {
+        p[i] = glm::vec3(pos(rng), pos(rng), pos(rng));
+        glm::vec3 d;
+        do { d = glm::vec3(unit(rng), unit(rng), unit(rng)); } while (glm::dot(d, d) < 1e-4f);
+        n[i] = glm::normalize(d);
+        c[i] = glm::vec3(col(rng), col(rng), col(rng));
+    }
+
+    std::vector<PackedVertex> packed(count);
+    double ns = nsPerOp([&]
+        {
+            for (int i = 0; i < count; ++i)
+                packed[i] = packVertex(p[i], n[i], c[i]);
+            benchSink = benchSink + packed[0].position[0];
+        }, 20);
+    std::snprintf(extra, sizeof(extra), "%.2f ns/vertex", ns / count);
+    reportRow("packVertex x65536 (random)", ns, extra);
+
+    RoundTripError random;
+    for (int i = 0; i < count; ++i)
+        random.add(p[i], n[i], c[i]);
+    checkBounds("random", random);
+
+    // Edge inputs: every corner of the chunk's extent, the six axis
+    // normals, normals on and beside the z = 0 fold of both hemispheres
+    // and the diagonals, with every 0/1 colour
+    const float width = float(CHUNK_SIZE * VOXEL_SIZE), height = float(CHUNK_HEIGHT * VOXEL_SIZE);
+    std::vector<glm::vec3> corners, normals, colors;
+    for (int i = 0; i < 8; ++i)
+    {
+        corners.push_back(glm::vec3(i & 1 ? width : 0.0f, i & 2 ? height : 0.0f, i & 4 ? width : 0.0f));
+        colors.push_back(glm::vec3(i & 1 ? 1.0f : 0.0f, i & 2 ? 1.0f : 0.0f, i & 4 ? 1.0f : 0.0f));
+    }
+    for (int axis = 0; axis < 3; ++axis)
+        for (float sign : { -1.0f, 1.0f })
+        {
+            glm::vec3 a(0.0f);
+            a[axis] = sign;
+            normals.push_back(a);
+        }
+    for (float z : { -1e-3f, 0.0f, 1e-3f, -1.0f, 1.0f })
+        for (int quadrant = 0; quadrant < 4; ++quadrant)
+            normals.push_back(glm::normalize(glm::vec3(quadrant & 1 ? -1.0f : 1.0f, quadrant & 2 ? -1.0f : 1.0f, z)));
+
+    RoundTripError edges;
+    for (const glm::vec3& corner : corners)
+        for (const glm::vec3& normal : normals)
+            for (const glm::vec3& color : colors)
+                edges.add(corner, normal, color);
+    checkBounds("edge-case", edges);
+
+    // Corners and 0/1 colours sit exactly on a quantization step
+    bool exact = true;
+    for (std::size_t i = 0; i < corners.size(); ++i)
+    {
+        PackedVertex v = packVertex(corners[i], normals[0], colors[i]);
+        exact &= unpackPosition(v) == corners[i] && unpackColor(v) == colors[i];
+    }
+    benchCheck(exact, "chunk corners or 0/1 colours do not round-trip exactly");
+
+    // Real terrain sizes, for the per-chunk memory saving
+    BiomeManager biome(1.0f, WATER_LEVEL_WORLD);
+    std::size_t vertices = 0, triangles = 0;
+    for (glm::ivec2 cp : { glm::ivec2(0, 0), glm::ivec2(-40, 17), glm::ivec2(100, 100) })
+    {
+        Chunk chunk(cp, &biome);
+        std::vector<PackedVertex> v;
+        std::vector<unsigned int> idx;
+        chunk.generateData(v, idx);
+        vertices += v.size();
+        triangles += idx.size() / 3;
+    }
+    std::printf("  terrain: %zu vertices, %zu triangles over 3 chunks\n", vertices, triangles);
+    std::printf("  vertex bytes: %zu packed vs %zu float streams (%.1fx smaller)\n",
+        sizeof(PackedVertex), 3 * sizeof(glm::vec3), double(3 * sizeof(glm::vec3)) / sizeof(PackedVertex));
+}
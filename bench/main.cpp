@@ -0,0 +1,131 @@
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "Bench.h"
+
+volatile double benchSink = 0.0;
+
+// Benchmarks, one per file
+void benchDensityLayout();
+void benchNoiseBatch();
+void benchJobSystem();
+void benchVertexPack();
+void benchMeshArena();
+void benchDrawCommands();
+void benchFrustumCull();
+void benchChunkQuadtree();
+void benchChunkGrid();
+void benchStreaming();
+void benchLodMeshing();
+void benchRegionCache();
+void benchMeshBlob();
+void benchHeadlessWorld();
+void benchReplay();
+void benchHotPaths();
+
+struct BenchEntry
+{
+    const char* name;
+    void (*run)();
+    const char* description;
+};
+
+static const BenchEntry benches[] = {
+    { "density", benchDensityLayout, "Flat vs nested density storage on the meshing loop" },
+    { "noise",   benchNoiseBatch,    "Batched SIMD OpenSimplex2 and BiomeManager::sampleGrid" },
+    { "jobs",    benchJobSystem,     "Chunk task dispatch: tasks/sec and utilisation at 4/16/64 threads" },
+    { "vertexpack", benchVertexPack, "PackedVertex quantization error and packing cost" },
+    { "arena",   benchMeshArena,     "MeshArena churn against a fake GPU: correctness, occupancy, fragmentation" },
+    { "drawlist", benchDrawCommands, "Per-frame multi-draw command list: build cost and draw calls per frame" },
+    { "cull",    benchFrustumCull,   "Per-chunk frustum test vs SoA batch culling at 10k and 100k chunks" },
+    { "quadtree", benchChunkQuadtree, "Chunk quadtree: hierarchical culling and unload queries at radius 8/24/32/64" },
+    { "grid",    benchChunkGrid,     "Loaded-chunk container: unordered_map vs toroidal ChunkGrid" },
+    { "stream",  benchStreaming,     "World streaming scans per camera chunk crossing at r = 8/32/128, full rescan vs ring diff" },
+    { "lod",     benchLodMeshing,    "LOD meshing cost per level and watertight seams between levels" },
+    { "regions", benchRegionCache,   "Region cache: cold generation vs warm mapped loads over a fixed flythrough" },
+    { "meshblob", benchMeshBlob,     "Mesh blob round trip, damage detection and serialize/validate throughput" },
+    { "world",   benchHeadlessWorld, "Headless World flythrough on a recording GPU: reproducible streaming and draw counters" },
+    { "replay",  benchReplay,        "Camera path replay: load-to-draw latency, holes and frame costs as JSON (--path=, --json=)" },
+    { "hotpaths", benchHotPaths,     "Terrain generation hot paths on ocean, coast, hill and upland chunks: ns/op, samples and triangles" },
+};
+
+static int failedChecks = 0;
+
+bool benchCheck(bool passed, const char* what)
+{
+    if (!passed)
+    {
+        std::printf("  FAILED: %s\n", what);
+        ++failedChecks;
+    }
+    return passed;
+}
+
+static int optionCount = 0;
+static char** optionArgs = nullptr;
+
+const char* benchOption(const char* name, const char* fallback)
+{
+    std::size_t length = std::strlen(name);
+    for (int i = 0; i < optionCount; ++i)
+    {
+        const char* arg = optionArgs[i];
+        if (std::strncmp(arg, "--", 2) == 0 && std::strncmp(arg + 2, name, length) == 0 && arg[2 + length] == '=')
+            return arg + 3 + length;
+    }
+    return fallback;
+}
+
+/* ------------------------- */
+/* Usage: TerrainBench [name...] [--option=value...] */
+/* Runs every benchmark when no names are given. Exits 2 if any */
+/* correctness check failed, so a regression fails the run */
+/* ------------------------- */
+int main(int argc, char** argv)
+{
+    optionCount = argc - 1;
+    optionArgs = argv + 1;
+
+    int names = 0;
+    for (int i = 1; i < argc; ++i)
+        if (std::strncmp(argv[i], "--", 2) != 0)
+            ++names;
+
+    int ran = 0;
+    std::vector<const char*> failedBenches;
+    for (const BenchEntry& b : benches)
+    {
+        bool selected = names == 0;
+        for (int i = 1; i < argc; ++i)
+            if (std::strcmp(argv[i], b.name) == 0)
+                selected = true;
+
+        if (!selected)
+            continue;
+
+        std::printf("[%s] %s\n", b.name, b.description);
+        int failedBefore = failedChecks;
+        b.run();
+        ++ran;
+        if (failedChecks != failedBefore)
+            failedBenches.push_back(b.name);
+    }
+
+    if (ran == 0)
+    {
+        std::printf("Available benchmarks:\n");
+        for (const BenchEntry& b : benches)
+            std::printf("  %-12s %s\n", b.name, b.description);
+        return 1;
+    }
+
+    if (!failedBenches.empty())
+    {
+        std::printf("%d checks FAILED in:", failedChecks);
+        for (const char* name : failedBenches)
+            std::printf(" %s", name);
+        std::printf("\n");
+        return 2;
+    }
+    return 0;
+}
@@ -1,5 +1,15 @@
 #pragma once
 #include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+
+// One FNV-1a step: folds bytes into the running hash h
+inline void hashBytes(std::uint64_t& h, const void* data, std::size_t bytes)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < bytes; ++i)
+        h = (h ^ p[i]) * 0x100000001B3ull;
+}
 
 class Biome
 {
@@ -9,6 +19,17 @@ public:
     // Height of solid ground at world-space (x,z) in *world units*
     virtual float getHeight(float wx, float wz) const = 0;
 
+    // Batched getHeight: out[i] = getHeight(wx[i], wz[i]) for count points
+    virtual void getHeights(const float* wx, const float* wz, float* out, int count) const
+    {
+        for (int i = 0; i < count; ++i)
+            out[i] = getHeight(wx[i], wz[i]);
+    }
+
     // Colour you want on top of that ground (later you might add vegetation masks, etc.)
     virtual glm::vec3 getSurfaceColor(float wy) const = 0;
+
+    // Folds every noise setting behind getHeight into h (see
+    // BiomeManager::generatorKey); formulas are covered by GENERATOR_VERSION
+    virtual void hashParams(std::uint64_t& h) const = 0;
 };
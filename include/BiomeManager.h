@@ -1,8 +1,11 @@
 #pragma once
 #include "PlainsBiome.h"
 #include "OceanBiome.h"
+#include <cstdint>
 #include <memory>
 
+#define DEFAULT_TERRAIN_SEED 1337   // FastNoiseLite's default seed, which every layer used before seeds were configurable
+
 struct BiomeSample
 {
     float height;          // blended height
@@ -12,14 +15,31 @@ struct BiomeSample
 class BiomeManager
 {
     FastNoiseLite biomeNoise;                    // selects between biomes
+    Simplex2Params biomeParams;                  // biomeNoise settings for batched sampling
     std::unique_ptr<PlainsBiome> plains;
     std::unique_ptr<OceanBiome>  ocean;
+    float voxelScale, waterLevel;                // Constructor arguments, for generatorKey
+
+    // Blends the biome heights by the biome mask
+    static BiomeSample blend(float mask, float hOcean, float hPlains);
 public:
-    BiomeManager(float voxelScale, float waterLevelWorld);
+    // seed feeds every noise layer (and so generatorKey)
+    BiomeManager(float voxelScale, float waterLevelWorld, int seed = DEFAULT_TERRAIN_SEED);
 
     BiomeSample sample(float wx, float wz) const;
 
-    glm::vec3 blendedSurfaceColor(float wy, float oceanW, float wx, float wz) const;
+    // Samples an nx * nz grid of points origin + (ix, iz) * step in one batch
+    // out[ix * nz + iz] matches sample() at that point (see simplex2Batch)
+    void sampleGrid(glm::vec2 origin, float step, int nx, int nz, BiomeSample* out) const;
 
+    // Surface colour at height wy: sand along the waterline where nearOcean,
+    // otherwise the biome colours blended by oceanW
+    glm::vec3 surfaceColor(float wy, float oceanW, bool nearOcean) const;
+
+    // True if the biome mask turns oceanish within 4 voxels of (wx, wz)
     bool nearOcean(float wx, float wz) const;
+
+    // Hash of everything that decides the terrain this manager produces
+    // Data cached under one key is stale under any other
+    std::uint64_t generatorKey() const;
 };
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#define CAMERA_PATH_TICK_HZ 60     // Keys per second when recording from the game
+
+/* ------------------------- */
+/* One camera pose, in Camera's terms (yaw and pitch in degrees) */
+/* ------------------------- */
+struct CameraKey
+{
+    glm::vec3 position;
+    float yaw, pitch;
+};
+
+/* ------------------------- */
+/* CameraPath: a camera pose per fixed tick, recorded from the game or */
+/* scripted, and replayed against a World at the same tick rate. */
+/* Stored as text: a "camerapath <version> <tickHz>" line, then one */
+/* "x y z yaw pitch" line per tick, so recorded flights can be edited */
+/* and kept next to the benchmark results they produced */
+/* ------------------------- */
+class CameraPath
+{
+public:
+    explicit CameraPath(double tickHz = CAMERA_PATH_TICK_HZ);
+
+    void add(const CameraKey& key) { keys.push_back(key); }
+    void clear() { keys.clear(); }
+
+    std::size_t size() const { return keys.size(); }
+    bool empty() const { return keys.empty(); }
+    const CameraKey& operator[](std::size_t tick) const { return keys[tick]; }
+
+    double tickRate() const { return hz; }
+    double tickSeconds() const { return 1.0 / hz; }
+
+    // False if the file cannot be written
+    bool save(const std::string& path) const;
+
+    // False (and the path left empty) if the file is missing or malformed
+    bool load(const std::string& path);
+
+    // View matrix of a pose, as Camera::GetViewMatrix computes it
+    static glm::mat4 viewMatrix(const CameraKey& key);
+
+private:
+    double hz;
+    std::vector<CameraKey> keys;
+};
@@ -3,8 +3,12 @@
 #include <glm/glm.hpp>
 #include <vector>
 #include "Mesh.h"
+#include "MeshArena.h"
+#include "DensityGrid.h"
 #include "../include/BiomeManager.h"
 
+class HeightTileCache;
+
 /* ------------------------- */
 /* Configuration constants */
 /* ------------------------- */
@@ -19,6 +23,28 @@
 #define HEIGHT_VARIATION_WORLD  (CHUNK_HEIGHT * VOXEL_SIZE / 4)
 #define WATER_LEVEL_WORLD       (BASE_HEIGHT_WORLD)
 
+// Memory layout of the density field. The meshing loop runs x-z-y, but XZY
+// is no faster: over 8 interleaved "hotpaths" runs, polygoniseCube stays
+// within 3% either way (the 35^3 field sits in L2), while filling the field,
+// vectorised along z under XYZ, costs 58-63 us per chunk instead of 48-52
+#define DENSITY_AXIS_ORDER      AxisOrder::XYZ
+
+// Voxels between BiomeManager::nearOcean samples; chunks look it up on a
+// world-aligned lattice instead of sampling it per vertex
+#define NEAR_OCEAN_SPACING 4
+
+// Levels of detail: LOD n samples the density every (1 << n) voxels
+#define LOD_LEVELS 4
+
+static_assert(CHUNK_SIZE % (1 << (LOD_LEVELS - 1)) == 0 && CHUNK_HEIGHT % (1 << (LOD_LEVELS - 1)) == 0,
+    "Chunk extent must be divisible by the coarsest LOD stride");
+static_assert(CHUNK_SIZE % NEAR_OCEAN_SPACING == 0, "Chunks must share the nearOcean lattice");
+
+// Chunk-local vertex positions must fit PackedVertex's 16-bit coordinates
+static_assert(CHUNK_SIZE * VOXEL_SIZE * POSITION_STEPS_PER_UNIT <= 65535 &&
+    CHUNK_HEIGHT * VOXEL_SIZE * POSITION_STEPS_PER_UNIT <= 65535,
+    "Chunk extent too large for POSITION_STEPS_PER_UNIT");
+
 /* ------------------------- */
 /* Chunk class: represents a voxel chunk with density field and mesh data */
 /* Responsible for generating terrain data and mesh via marching cubes */
@@ -26,59 +52,194 @@
 class Chunk
 {
 public:
+    // Chunk sides in XZ; each LOD > 0 mesh has one transition strip per face
+    enum Face
+    {
+        FACE_NEG_X, FACE_POS_X, FACE_NEG_Z, FACE_POS_Z, FACE_COUNT
+    };
+
+    // A run of the mesh's index array
+    struct IndexRange
+    {
+        unsigned first, count;
+    };
+
+    // Everything a built mesh needs besides its vertices and indices
+    // Plain data: cached meshes store it as-is
+    struct MeshInfo
+    {
+        unsigned regularCount;
+        IndexRange transitions[FACE_COUNT];
+        glm::vec3 meshMin, meshMax;
+    };
+
     // Constructor takes chunk position in chunk coordinates (x,z)
-    explicit Chunk(glm::ivec2 pos, const BiomeManager* biomeMgr);
+    // Column samples come from tileCache when given (LOD 0 only), otherwise straight from biomeMgr
+    explicit Chunk(glm::ivec2 pos, const BiomeManager* biomeMgr, HeightTileCache* tileCache = nullptr,
+        int lodLevel = 0);
 
-    // Destructor cleans up allocated mesh
+    // Destructor returns the mesh's arena ranges
     ~Chunk();
 
-    // Draws the mesh with provided shader
+    // Draws the mesh with provided shader; the arena must be bound
     void draw(const Shader& shader);
 
     // Generates mesh data arrays from density field
     // Returns true if mesh was generated, false if empty
-    bool generateData(std::vector<glm::vec3>& vertices,
-        std::vector<glm::vec3>& colors,
-        std::vector<glm::vec3>& normals,
+    // Vertex positions are chunk-local; add origin() for world space
+    bool generateData(std::vector<PackedVertex>& vertices,
         std::vector<unsigned int>& indices);
 
-    // Uploads vertex data to GPU buffers and prepares mesh for drawing
-    void finalize(std::vector<glm::vec3>& vertices,
-        std::vector<glm::vec3>& colors,
-        std::vector<glm::vec3>& normals,
-        std::vector<unsigned int>& indices);
+    // Uploads vertex data into the shared mesh arena and prepares it for drawing
+    void finalize(MeshArena* meshArena,
+        const std::vector<PackedVertex>& vertices,
+        const std::vector<unsigned int>& indices);
+    void finalize(MeshArena* meshArena,
+        const PackedVertex* vertices, std::size_t vertexCount,
+        const unsigned int* indices, std::size_t indexCount);
+
+    // Description of the mesh generateData built, for caching it
+    MeshInfo meshInfo() const;
+
+    // Adopts a mesh built earlier (e.g. loaded from the region cache)
+    // in place of generateData; finalize it with that mesh's arrays
+    void restoreMesh(const MeshInfo& info);
+
+    // World position of the chunk's local (0, 0, 0)
+    glm::vec3 origin() const;
+
+    // World-space box around the generated mesh (empty until generateData)
+    void bounds(glm::vec3& minCorner, glm::vec3& maxCorner) const;
+
+    // Arena handle of the uploaded mesh, INVALID_MESH before finalize or when empty
+    MeshHandle mesh() const { return meshHandle; }
+
+    // Level of detail: cells are (1 << lod()) voxels wide
+    int lod() const { return level; }
+
+    // Neighbouring chunk offset across a face
+    static glm::ivec2 faceDirection(int face);
+
+    // Indices of the regular cells (drawn always)
+    IndexRange regularIndices() const { return { 0u, regularCount }; }
+
+    // Indices of the strip that closes a face against a neighbour one LOD finer
+    // Drawn only while that neighbour is finer; empty at LOD 0
+    IndexRange transitionIndices(int face) const { return transitions[face]; }
 
     // Chunk position in chunk grid coordinates
     glm::ivec2 position;
 
 private:
+    // The hot-path benchmark times the generation stages one at a time
+    friend struct ChunkStages;
+
+    /* ------------------------- */
+    /* Vertex IDs of the lattice edges around one x slab (planes x and x+1) */
+    /* so each crossed edge emits a single shared vertex. -1 = not emitted */
+    /* ------------------------- */
+    struct EdgeCache
+    {
+        int rowLength;             // Lattice points along z
+        std::vector<int> xEdges;   // x-edges starting on plane x: [y][z]
+        std::vector<int> lo, hi;   // y/z-edges on planes x and x+1: [y][z][axis-1]
+
+        EdgeCache(int cellsY, int cellsZ);
+
+        // Moves on to the next slab: plane x+1 becomes plane x
+        void advance();
+
+        // Vertex ID slot for the lattice edge at (x+dx, y, z) along axis
+        int& at(int dx, int y, int z, int axis);
+    };
+
     // BiomeManager to know what biome the chunk is
     const BiomeManager* biome;
 
-    // 3D density field: density[x][y][z]
-    std::vector<std::vector<std::vector<float>>> density;
-
-    Mesh* mesh;      // Mesh object containing vertex buffers, etc.
+    // Shared heightmap tiles (may be null)
+    HeightTileCache* tiles;
+
+    int level;       // LOD
+    int cells;       // Cells per side (CHUNK_SIZE >> level)
+    int layers;      // Cell layers (CHUNK_HEIGHT >> level)
+    int step;        // Cell size in world units (VOXEL_SIZE << level)
+
+    // 3D density field: density.at(x, y, z), with a one-voxel apron on every side
+    DensityGrid density;
+    std::ptrdiff_t cornerOffset[8];  // Flat offsets of the cube corners in density
+
+    // Per-column biome samples (height, oceanWeight) for x,z in [-1, cells + 1]
+    // The terrain is a heightfield, so every voxel in a column shares one sample.
+    // The one-column apron lets normals use central differences at chunk borders
+    std::vector<BiomeSample> columns;
+
+    // nearOcean at every NEAR_OCEAN_SPACING voxels across the chunk, edges included
+    // nearOceanLattice[x * (CHUNK_SIZE / NEAR_OCEAN_SPACING + 1) + z], 1 if near
+    std::vector<unsigned char> nearOceanLattice;
+
+    // Heights halfway between the border columns, one row per face (LOD > 0)
+    // faceMidHeights[face * cells + i] lies between border columns i and i + 1
+    std::vector<float> faceMidHeights;
+
+    // Per cell column (x,z): the y range of cells the surface can cross
+    // cellBands[x * cells + z], empty when yMin > yMax
+    struct CellBand
+    {
+        int yMin, yMax;
+    };
+    std::vector<CellBand> cellBands;
+
+    MeshArena* arena;        // Arena holding the mesh (null until finalized)
+    MeshHandle meshHandle;   // Ranges of the arena buffers, INVALID_MESH if none
+    glm::vec3 meshMin, meshMax;   // Chunk-local mesh bounds
+    unsigned regularCount;                // Indices before the transition strips
+    IndexRange transitions[FACE_COUNT];   // Transition strip of each face
     bool dirty;      // Flag indicating mesh needs rebuilding
 
-    // Retrieves density value at voxel coordinates (including boundary)
-    float getDensityAt(int x, int y, int z);
+    // Retrieves density value at lattice coordinates
+    // Valid for x,z in [-1, cells + 1] and y in [-1, layers + 1]
+    float getDensityAt(int x, int y, int z) const;
+
+    // Samples the biome once per (x,z) column into the column table
+    void sampleColumns();
 
-    // Fills the density field based on procedural noise functions
+    // Samples nearOcean over the chunk into nearOceanLattice
+    void sampleNearOcean();
+
+    // Column sample at lattice (x,z), valid for x,z in [-1, cells + 1]
+    const BiomeSample& columnAt(int x, int z) const;
+
+    // Lattice column of border point i along a face
+    glm::ivec2 faceColumn(int face, int i) const;
+
+    // Density gradient at lattice column (x,z) by central differences on the column table
+    glm::vec3 latticeGradient(int x, int z) const;
+
+    // Quantized vertex coloured from the column table and nearOceanLattice
+    PackedVertex surfaceVertex(const glm::vec3& vLocal, const glm::vec3& normal) const;
+
+    // Fills the density field from the column table
     void generateDensityField();
 
+    // Computes cellBands from the min/max corner height of each cell column
+    void computeCellBands();
+
     // Builds mesh vertex/index data using marching cubes polygonization
-    void buildMeshData(std::vector<glm::vec3>& vertices,
-        std::vector<glm::vec3>& colors,
-        std::vector<glm::vec3>& normals,
+    void buildMeshData(std::vector<PackedVertex>& vertices,
         std::vector<unsigned int>& indices);
 
     // Runs marching cubes on a single cube within the density field
+    // Vertices on edges already in the cache are reused instead of duplicated
     void polygoniseCube(int x, int y, int z,
-        std::vector<glm::vec3>& vertices,
-        std::vector<glm::vec3>& colors,
-        std::vector<glm::vec3>& normals,
+        std::vector<PackedVertex>& vertices,
         std::vector<unsigned int>& indices,
-        int& indexOffset,
+        EdgeCache& edgeCache,
         float isoLevel);
+
+    // Appends one face's transition strip: triangles in the face plane that
+    // fill the gap between this chunk's border and the border a neighbour
+    // one LOD finer meshes along the same face
+    void buildTransition(int face,
+        std::vector<PackedVertex>& vertices,
+        std::vector<unsigned int>& indices);
 };
\ No newline at end of file
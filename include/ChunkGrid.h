@@ -0,0 +1,79 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <vector>
+
+class Chunk;
+
+/* ------------------------- */
+/* ChunkGrid: loaded chunks in a fixed toroidal array */
+/* Chunk (x,z) lives in slot (x mod side, z mod side). Each slot keeps */
+/* the position it holds, so as the window moves a slot is simply */
+/* reused by the chunk that now maps to it. With side > 2 * radius, */
+/* two chunks in one slot are never both within radius of the centre */
+/* ------------------------- */
+class ChunkGrid
+{
+public:
+    struct Entry
+    {
+        glm::ivec2 pos;
+        Chunk* chunk;   // Null when the slot is empty
+    };
+
+    // Iterates occupied slots in memory order
+    class Iterator
+    {
+    public:
+        Iterator(const Entry* at, const Entry* end) : at(at), end(end) { skipEmpty(); }
+
+        const Entry& operator*() const { return *at; }
+        const Entry* operator->() const { return at; }
+        Iterator& operator++() { ++at; skipEmpty(); return *this; }
+        bool operator!=(const Iterator& other) const { return at != other.at; }
+
+    private:
+        void skipEmpty() { while (at != end && !at->chunk) ++at; }
+
+        const Entry* at;
+        const Entry* end;
+    };
+
+    // The side is minSize rounded up to a power of two
+    explicit ChunkGrid(int minSize);
+
+    // The chunk at pos, or null
+    Chunk* find(glm::ivec2 pos) const;
+    bool contains(glm::ivec2 pos) const { return find(pos) != nullptr; }
+
+    // Stores chunk at pos. Returns the chunk it displaces from the slot
+    // (a stale one from an old window position), or null; the caller owns it
+    Chunk* insert(glm::ivec2 pos, Chunk* chunk);
+
+    // Empties pos and returns its chunk (null if not loaded); the caller owns it
+    Chunk* erase(glm::ivec2 pos);
+
+    void clear();
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    int sideLength() const { return side; }
+
+    // Appends the positions of the square window around center that lie
+    // outside the same-sized window around other: what enters (or, with
+    // the centres swapped, leaves) when a window moves from other to center
+    static void windowDifference(glm::ivec2 center, glm::ivec2 other, int radius, std::vector<glm::ivec2>& out);
+
+    // Appends the positions at Chebyshev distance exactly r from center
+    static void ring(glm::ivec2 center, int r, std::vector<glm::ivec2>& out);
+
+    Iterator begin() const { return Iterator(slots.data(), slots.data() + slots.size()); }
+    Iterator end() const { return Iterator(slots.data() + slots.size(), slots.data() + slots.size()); }
+
+private:
+    std::size_t slotIndex(glm::ivec2 pos) const;
+
+    int side, shift;            // side == 1 << shift
+    std::vector<Entry> slots;   // slots[(x mod side) * side + (z mod side)]
+    std::size_t count = 0;
+};
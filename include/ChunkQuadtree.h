@@ -0,0 +1,86 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Frustum.h"
+#include "Vec2Hash.h"
+
+/* ------------------------- */
+/* ChunkQuadtree: loaded chunks in sparse quadtrees over XZ */
+/* The plane is split into tiles of TILE_CHUNKS^2 chunks, each the root of */
+/* a quadtree down to single chunks. Every node keeps the min/max height */
+/* of the chunks below it, so culling and window queries can accept or */
+/* reject whole subtrees. Insert and remove touch one root-to-leaf path */
+/* ------------------------- */
+class ChunkQuadtree
+{
+public:
+    static constexpr int TILE_LEVELS = 5;                  // Node levels below a tile root
+    static constexpr int TILE_CHUNKS = 1 << TILE_LEVELS;   // Chunks per tile side
+
+    // chunkWorldSize is the world-space width of one chunk
+    explicit ChunkQuadtree(float chunkWorldSize);
+
+    // Adds the chunk at pos, or replaces its id and height range
+    void insert(glm::ivec2 pos, std::uint32_t id, float minY, float maxY);
+    void remove(glm::ivec2 pos);
+    void clear();
+
+    bool contains(glm::ivec2 pos) const;
+    std::size_t size() const { return count; }
+
+    // Replaces visible with the ids of chunks whose box intersects the frustum
+    void cull(const Frustum& frustum, std::vector<std::uint32_t>& visible) const;
+
+    // Appends the positions of chunks farther than radius (Chebyshev) from center
+    void collectOutside(glm::ivec2 center, int radius, std::vector<glm::ivec2>& out) const;
+
+    // Appends the positions of chunks within radius (Chebyshev) of center
+    void collectWithin(glm::ivec2 center, int radius, std::vector<glm::ivec2>& out) const;
+
+    std::size_t nodeCount() const { return nodes.size() - freeNodes.size(); }
+
+private:
+    static constexpr std::uint32_t NO_NODE = ~std::uint32_t(0);
+    static constexpr unsigned ALL_PLANES = 0x3F;
+
+    struct Node
+    {
+        std::uint32_t children[4];   // Quadrant (x bit 0, z bit 1) -> node, NO_NODE if empty
+        float minY, maxY;            // Height range of the chunks below
+        std::uint32_t chunks;        // Chunks below (1 for a leaf)
+        std::uint32_t id;            // Leaf payload
+    };
+
+    // Square of chunks covered by a node
+    struct Cell
+    {
+        glm::ivec2 origin;
+        int level;                   // Side is 1 << level chunks
+    };
+
+    static glm::ivec2 tileOf(glm::ivec2 pos);
+    static int quadrant(glm::ivec2 pos, const Cell& cell);
+    static Cell child(const Cell& cell, int quadrant);
+
+    std::uint32_t allocateNode();
+    void freeNode(std::uint32_t node);
+
+    // Recomputes a node's height range and count from its children
+    void refit(std::uint32_t node);
+
+    void cullNode(std::uint32_t node, const Cell& cell, const Frustum& frustum, unsigned planes,
+        std::vector<std::uint32_t>& visible) const;
+    void collectAll(std::uint32_t node, const Cell& cell, std::vector<glm::ivec2>& out) const;
+    void collectIds(std::uint32_t node, int level, std::vector<std::uint32_t>& out) const;
+    void collectWindow(std::uint32_t node, const Cell& cell, glm::ivec2 center, int radius, bool inside,
+        std::vector<glm::ivec2>& out) const;
+
+    float chunkSize;
+    std::unordered_map<glm::ivec2, std::uint32_t, Vec2Hash> tiles;   // Tile coordinate -> root node
+    std::vector<Node> nodes;
+    std::vector<std::uint32_t> freeNodes;
+    std::size_t count = 0;
+};
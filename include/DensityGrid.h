@@ -0,0 +1,59 @@
+#pragma once
+#include <memory>
+#include <cstddef>
+
+/* ------------------------- */
+/* Memory layout of a DensityGrid, slowest to fastest varying axis */
+/* ------------------------- */
+enum class AxisOrder
+{
+    XYZ, XZY, YXZ, YZX, ZXY, ZYX
+};
+
+/* ------------------------- */
+/* DensityGrid: flat, cache-line aligned 3D float field */
+/* Holds sizeX * sizeY * sizeZ lattice points plus a one-voxel apron */
+/* on every side, so valid coordinates are [-1, size] on each axis */
+/* ------------------------- */
+class DensityGrid
+{
+public:
+    DensityGrid(int sizeX, int sizeY, int sizeZ, AxisOrder order = AxisOrder::XYZ);
+
+    float& at(int x, int y, int z) { return data[index(x, y, z)]; }
+    float at(int x, int y, int z) const { return data[index(x, y, z)]; }
+
+    // Flat offset of (x,y,z); neighbours along an axis are stride() apart
+    std::ptrdiff_t index(int x, int y, int z) const
+    {
+        return origin + x * strideX + y * strideY + z * strideZ;
+    }
+
+    std::ptrdiff_t stride(int axis) const
+    {
+        return axis == 0 ? strideX : (axis == 1 ? strideY : strideZ);
+    }
+
+    // Pointer to (x,y,z) for walking neighbours with precomputed offsets
+    const float* ptr(int x, int y, int z) const { return data + index(x, y, z); }
+
+    // Flat offsets of the 8 marching cubes corners (vertexOffsets order)
+    // relative to the cube's origin corner
+    void cornerOffsets(std::ptrdiff_t out[8]) const;
+
+    AxisOrder order() const { return axisOrder; }
+
+    // Bytes of the padded field (excluding alignment slack)
+    std::size_t bytes() const { return count * sizeof(float); }
+
+    static constexpr std::size_t ALIGNMENT = 64;  // Cache line
+
+private:
+    std::unique_ptr<float[]> storage;  // Backing memory, over-allocated for alignment
+    float* data;                  // First cache-line aligned float in storage
+    std::size_t count;            // Padded points in the field
+
+    AxisOrder axisOrder;
+    std::ptrdiff_t strideX, strideY, strideZ;
+    std::ptrdiff_t origin;        // Offset of lattice point (0,0,0)
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/* ------------------------- */
+/* One indexed draw, laid out exactly as GL's */
+/* DrawElementsIndirectCommand so the array uploads as-is */
+/* ------------------------- */
+struct DrawElementsIndirectCommand
+{
+    std::uint32_t count;          // Indices
+    std::uint32_t instanceCount;  // Always 1
+    std::uint32_t firstIndex;     // Into the shared index buffer
+    std::int32_t baseVertex;      // Added to every index
+    std::uint32_t baseInstance;   // Unused (0)
+};
+
+static_assert(sizeof(DrawElementsIndirectCommand) == 20, "Must match the GL indirect command layout");
+
+/* ------------------------- */
+/* DrawCommandList: the visible meshes of a frame as one multi-draw */
+/* Pure CPU: filled by World, submitted by the render backend either as */
+/* an indirect buffer or as glMultiDrawElementsBaseVertex arrays */
+/* ------------------------- */
+class DrawCommandList
+{
+public:
+    void clear();
+
+    // Appends one mesh range (indexCount == 0 is ignored)
+    void add(unsigned indexCount, std::size_t firstIndex, int baseVertex);
+
+    // Counts meshes that were tested and rejected, for reporting
+    void addCulled(std::size_t count = 1) { culled += count; }
+
+    // Indirect form
+    const std::vector<DrawElementsIndirectCommand>& commands() const { return indirect; }
+
+    // glMultiDrawElementsBaseVertex form (index byte offsets as pointers)
+    const std::vector<int>& counts() const { return drawCounts; }
+    const std::vector<const void*>& indexOffsets() const { return offsets; }
+    const std::vector<int>& baseVertices() const { return bases; }
+
+    std::size_t drawCount() const { return indirect.size(); }
+    std::size_t culledCount() const { return culled; }
+    std::uint64_t triangleCount() const { return triangles; }
+
+private:
+    std::vector<DrawElementsIndirectCommand> indirect;
+    std::vector<int> drawCounts;
+    std::vector<const void*> offsets;
+    std::vector<int> bases;
+    std::size_t culled = 0;
+    std::uint64_t triangles = 0;
+};
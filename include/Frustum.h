@@ -0,0 +1,17 @@
+#pragma once
+#include <glm/glm.hpp>
+
+/* ------------------------- */
+/* Frustum: the six clip planes of a view-projection matrix */
+/* Extracted and normalised once per frame, then shared by every box test */
+/* ------------------------- */
+struct Frustum
+{
+    glm::vec4 planes[6];       // Left, right, bottom, top, near, far; inside when dot(n, p) + w >= 0
+    glm::vec3 absNormals[6];   // |n| per plane, for the box radius
+
+    explicit Frustum(const glm::mat4& viewProj);
+
+    // True if the box touches or is inside the frustum
+    bool intersects(const glm::vec3& minCorner, const glm::vec3& maxCorner) const;
+};
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Frustum.h"
+#include "NoiseBatch.h"
+
+/* ------------------------- */
+/* FrustumCuller: axis-aligned boxes in structure-of-arrays form, */
+/* tested against a frustum several at a time with SSE or AVX */
+/* World culls through it while few enough chunks are loaded that one */
+/* flat SIMD pass beats walking ChunkQuadtree (FLAT_CULL_MAX_CHUNKS) */
+/* Boxes are keyed by a small dense id such as a mesh handle; */
+/* removal moves the last box into the hole, so storage stays packed */
+/* ------------------------- */
+class FrustumCuller
+{
+public:
+    // Adds the box for id, or replaces it if id already has one
+    void set(std::uint32_t id, const glm::vec3& minCorner, const glm::vec3& maxCorner);
+    void remove(std::uint32_t id);
+    void clear();
+
+    std::size_t size() const { return ids.size(); }
+
+    // Replaces visible with the ids of the boxes that intersect the frustum, in storage order
+    void cull(const Frustum& frustum, std::vector<std::uint32_t>& visible) const;
+
+    // Same as cull but forces a SIMD level (must be supported), for benchmarks
+    void cullLevel(SimdLevel level, const Frustum& frustum, std::vector<std::uint32_t>& visible) const;
+
+private:
+    static constexpr std::uint32_t NO_SLOT = ~std::uint32_t(0);
+
+    // Box centres and half extents, one array per component
+    std::vector<float> centerX, centerY, centerZ;
+    std::vector<float> extentX, extentY, extentZ;
+    std::vector<std::uint32_t> ids;       // Id of each box
+    std::vector<std::uint32_t> slotOf;    // id -> index into the arrays, NO_SLOT if absent
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include "MeshArena.h"
+
+/* ------------------------- */
+/* GlArenaBackend: ArenaBackend on the current OpenGL context */
+/* Multi-draws use glMultiDrawElementsIndirect when the context has it */
+/* (GL 4.3 or ARB_multi_draw_indirect), else glMultiDrawElementsBaseVertex */
+/* ------------------------- */
+class GlArenaBackend : public ArenaBackend
+{
+public:
+    // Probes the current context for indirect drawing
+    GlArenaBackend();
+    ~GlArenaBackend() override;
+
+    unsigned createBuffer(BufferKind kind, std::size_t bytes) override;
+    void destroyBuffer(unsigned buffer) override;
+    void uploadBuffer(unsigned buffer, std::size_t offset, const void* data, std::size_t bytes) override;
+    void copyBuffer(unsigned src, std::size_t srcOffset, unsigned dst, std::size_t dstOffset, std::size_t bytes) override;
+
+    unsigned createVertexArray(unsigned vertexBuffer, unsigned indexBuffer) override;
+    void destroyVertexArray(unsigned vertexArray) override;
+
+    unsigned createBufferTexture(unsigned buffer) override;
+    void destroyTexture(unsigned texture) override;
+    void bindBufferTexture(unsigned texture) override;
+
+    void bindVertexArray(unsigned vertexArray) override;
+    void drawElementsBaseVertex(unsigned indexCount, std::size_t firstIndex, int baseVertex) override;
+    void multiDraw(const DrawCommandList& list) override;
+
+    bool usesIndirect() const { return multiDrawIndirect != nullptr; }
+
+    // Texture unit of the page table (the terrain shader's chunkOrigins sampler)
+    static constexpr int PAGE_TABLE_TEXTURE_UNIT = 1;
+
+private:
+    void* multiDrawIndirect = nullptr;   // glMultiDrawElementsIndirect, null when unavailable
+    unsigned indirectBuffer = 0;         // Command upload buffer (indirect path only)
+};
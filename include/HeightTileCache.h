@@ -0,0 +1,66 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "BiomeManager.h"
+#include "Vec2Hash.h"
+
+/* ------------------------- */
+/* A square tile of biome column samples */
+/* Tile (tx,tz) covers columns [tx, tx + 1) * SIZE by [tz, tz + 1) * SIZE */
+/* ------------------------- */
+struct HeightTile
+{
+    static constexpr int SIZE = 32;          // Columns per side (one chunk)
+
+    glm::ivec2 coord;                        // Tile coordinate
+    BiomeSample samples[SIZE * SIZE];        // samples[x * SIZE + z]
+};
+
+/* ------------------------- */
+/* HeightTileCache: bounded, thread-safe LRU of heightmap tiles */
+/* Shared by all chunk workers so neighbouring chunks and regenerated */
+/* chunks reuse column samples instead of re-running the noise */
+/* ------------------------- */
+class HeightTileCache
+{
+public:
+    HeightTileCache(const BiomeManager* biome, std::size_t capacityTiles);
+
+    // Returns the tile, computing and inserting it on a miss
+    std::shared_ptr<const HeightTile> get(glm::ivec2 coord);
+
+    // Copies columns [x0, x0 + nx) by [z0, z0 + nz) (world column coordinates)
+    // into out[x * nz + z], the layout of BiomeManager::sampleGrid
+    void fillColumns(int x0, int z0, int nx, int nz, BiomeSample* out);
+
+    std::uint64_t hits() const { return hitCount.load(std::memory_order_relaxed); }
+    std::uint64_t misses() const { return missCount.load(std::memory_order_relaxed); }
+    std::size_t size() const;
+
+private:
+    // One lock per shard keeps workers on different tiles from contending
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        std::list<std::shared_ptr<const HeightTile>> lru;   // Front = most recent
+        std::unordered_map<glm::ivec2,
+            std::list<std::shared_ptr<const HeightTile>>::iterator, Vec2Hash> index;
+    };
+
+    static constexpr int SHARD_COUNT = 16;
+
+    const BiomeManager* biome;
+    std::size_t shardCapacity;
+    Shard shards[SHARD_COUNT];
+
+    std::atomic<std::uint64_t> hitCount{ 0 };
+    std::atomic<std::uint64_t> missCount{ 0 };
+
+    Shard& shardFor(glm::ivec2 coord);
+    std::shared_ptr<const HeightTile> compute(glm::ivec2 coord) const;
+};
@@ -0,0 +1,93 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* ------------------------- */
+/* JobSystem: work-stealing thread pool with priority buckets */
+/* Each worker owns a set of deques (one per priority level); idle */
+/* workers steal from the others. Used by every chunk pipeline stage */
+/* ------------------------- */
+class JobSystem
+{
+public:
+    using Job = std::function<void()>;
+
+    static constexpr int PRIORITY_LEVELS = 8;   // 0 = most urgent
+
+    struct PrioritizedJob
+    {
+        Job job;
+        int priority;
+    };
+
+    // Per-pool counters, summed over workers
+    struct Stats
+    {
+        std::uint64_t executed = 0;     // Jobs run
+        std::uint64_t stolen = 0;       // Jobs run by a worker other than the one queued on
+        double busySeconds = 0.0;       // Time spent inside jobs
+    };
+
+    // threadCount <= 0 uses std::thread::hardware_concurrency()
+    explicit JobSystem(int threadCount = 0);
+
+    // Stops the workers; jobs still queued are discarded
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Queues one job; priority is clamped to [0, PRIORITY_LEVELS)
+    void submit(Job job, int priority = 0);
+
+    // Queues many jobs, spread across workers, and wakes every idle worker
+    void submitBatch(std::vector<PrioritizedJob>&& jobs);
+
+    // Blocks until every submitted job has finished
+    void waitIdle();
+
+    int threadCount() const { return int(workers.size()); }
+
+    Stats stats() const;
+
+private:
+    // Cache-line aligned so neighbouring workers don't false-share
+    struct alignas(64) WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<Job> buckets[PRIORITY_LEVELS];
+        std::atomic<int> size{ 0 };     // Lets thieves skip empty queues without locking
+
+        std::atomic<std::uint64_t> executed{ 0 };
+        std::atomic<std::uint64_t> stolen{ 0 };
+        std::atomic<std::uint64_t> busyNanos{ 0 };
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::atomic<int> queued{ 0 };           // Jobs sitting in any deque
+    std::atomic<int> unfinished{ 0 };       // Queued + running jobs
+    std::atomic<unsigned> nextQueue{ 0 };   // Round-robin target for external submits
+    bool stopping = false;
+
+    std::mutex sleepMutex;                  // Guards stopping and the wait predicates
+    std::condition_variable wakeCondition;  // Idle workers wait here
+    std::condition_variable idleCondition;  // waitIdle waits here
+
+    void workerLoop(int index);
+
+    // Queue to push to: the caller's own when it is a worker, else round-robin
+    int targetQueue();
+
+    void push(int queue, Job&& job, int priority);
+    bool popLocal(int index, Job& job);
+    bool steal(int index, Job& job);
+};
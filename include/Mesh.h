@@ -2,25 +2,24 @@
 #include <vector>
 #include <glm/glm.hpp>
 #include "Shader.h"
+#include "VertexFormat.h"
 
 class Mesh
 {
 public:
-    Mesh(const std::vector<glm::vec3>& vertices,
-        const std::vector<glm::vec3>& colors,
-        const std::vector<glm::vec3>& normals,
+    // Position-only float mesh (attribute 0), for flat helpers such as the water plane
+    Mesh(const std::vector<glm::vec3>& positions,
         const std::vector<unsigned int>& indices);
 
     ~Mesh();
 
     void draw() const;
 
+    // Points attributes 0-2 at PackedVertex fields of the bound GL_ARRAY_BUFFER
+    // (terrain meshes live in MeshArena; GlArenaBackend sets this up once)
+    static void setPackedVertexLayout();
+
 private:
-    unsigned int VAO, VBO_Vertices, VBO_Colors, VBO_Normals, EBO;
+    unsigned int VAO, VBO, EBO;
     unsigned int indexCount;
-
-    void setupMesh(const std::vector<glm::vec3>& vertices,
-        const std::vector<glm::vec3>& colors,
-        const std::vector<glm::vec3>& normals,
-        const std::vector<unsigned int>& indices);
 };
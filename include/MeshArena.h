@@ -0,0 +1,180 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include <glm/glm.hpp>
+#include "VertexFormat.h"
+#include "DrawCommandList.h"
+
+/* ------------------------- */
+/* ArenaBackend: the GL calls MeshArena needs, behind an interface */
+/* so the allocator can run headless against a fake implementation */
+/* ------------------------- */
+class ArenaBackend
+{
+public:
+    enum class BufferKind { Vertex, Index, PageTable };
+
+    virtual ~ArenaBackend() = default;
+
+    virtual unsigned createBuffer(BufferKind kind, std::size_t bytes) = 0;
+    virtual void destroyBuffer(unsigned buffer) = 0;
+    virtual void uploadBuffer(unsigned buffer, std::size_t offset, const void* data, std::size_t bytes) = 0;
+    virtual void copyBuffer(unsigned src, std::size_t srcOffset, unsigned dst, std::size_t dstOffset, std::size_t bytes) = 0;
+
+    // Vertex array with the PackedVertex layout over the given buffers
+    virtual unsigned createVertexArray(unsigned vertexBuffer, unsigned indexBuffer) = 0;
+    virtual void destroyVertexArray(unsigned vertexArray) = 0;
+
+    // RGBA32F buffer texture over a PageTable buffer, and binding it for the terrain shader
+    virtual unsigned createBufferTexture(unsigned buffer) = 0;
+    virtual void destroyTexture(unsigned texture) = 0;
+    virtual void bindBufferTexture(unsigned texture) = 0;
+
+    virtual void bindVertexArray(unsigned vertexArray) = 0;
+    virtual void drawElementsBaseVertex(unsigned indexCount, std::size_t firstIndex, int baseVertex) = 0;
+
+    // Submits a whole command list with the best multi-draw path available
+    virtual void multiDraw(const DrawCommandList& list) = 0;
+};
+
+/* ------------------------- */
+/* RangeAllocator: first-fit free list over [0, capacity) */
+/* Adjacent free ranges are merged on release */
+/* ------------------------- */
+class RangeAllocator
+{
+public:
+    static constexpr std::size_t INVALID = ~std::size_t(0);
+
+    explicit RangeAllocator(std::size_t capacity = 0);
+
+    // Returns the start of a free range of the given size, or INVALID
+    std::size_t allocate(std::size_t size);
+    void release(std::size_t offset, std::size_t size);
+
+    // Adds [capacity, newCapacity) to the free list
+    void grow(std::size_t newCapacity);
+
+    // Forgets every range: everything is allocated as [0, used), the rest is free
+    void resetPacked(std::size_t used);
+
+    std::size_t capacity() const { return total; }
+    std::size_t used() const { return total - freeTotal; }
+    std::size_t freeBlocks() const { return freeRanges.size(); }
+    std::size_t largestFree() const;
+
+    // 0 when all free space is one block, approaching 1 as it splinters
+    double fragmentation() const;
+
+private:
+    std::map<std::size_t, std::size_t> freeRanges;   // offset -> size
+    std::size_t total;
+    std::size_t freeTotal = 0;
+};
+
+using MeshHandle = std::uint32_t;
+static constexpr MeshHandle INVALID_MESH = 0;
+
+/* ------------------------- */
+/* MeshArena: all chunk meshes in one vertex and one index buffer */
+/* Meshes get ranges of each buffer and are drawn with a base vertex, so */
+/* loading and unloading chunks never creates or deletes GL objects. */
+/* When a mesh does not fit, the arena compacts (if fragmentation is the */
+/* problem) or moves everything into larger buffers. */
+/* Vertex ranges are whole pages of PAGE_VERTICES; a page table (buffer */
+/* texture) gives the chunk origin of every page, so the shader finds a */
+/* vertex's origin from gl_VertexID and one multi-draw covers all chunks */
+/* ------------------------- */
+class MeshArena
+{
+public:
+    static constexpr std::size_t PAGE_VERTICES = 256;   // Must match mc.vert
+
+    // Where one mesh lives; indices are relative to baseVertex
+    struct DrawRange
+    {
+        unsigned indexCount;
+        std::size_t firstIndex;
+        int baseVertex;
+    };
+
+    struct Stats
+    {
+        std::size_t liveMeshes = 0;
+        std::size_t vertexCapacity = 0, vertexUsed = 0;   // In vertices (used includes page padding)
+        std::size_t indexCapacity = 0, indexUsed = 0;     // In indices
+        std::size_t vertexFreeBlocks = 0, indexFreeBlocks = 0;
+        double vertexFragmentation = 0.0, indexFragmentation = 0.0;
+        std::uint64_t grows = 0;            // Buffer reallocations
+        std::uint64_t defragments = 0;      // Compactions
+        std::uint64_t bytesMoved = 0;       // GPU-side copies by grows and compactions
+    };
+
+    // The arena does not own the backend
+    MeshArena(ArenaBackend* backend, std::size_t initialVertices, std::size_t initialIndices);
+    ~MeshArena();
+
+    MeshArena(const MeshArena&) = delete;
+    MeshArena& operator=(const MeshArena&) = delete;
+
+    // Uploads a mesh whose positions are relative to origin and returns
+    // its handle (INVALID_MESH for an empty mesh)
+    MeshHandle allocate(const std::vector<PackedVertex>& vertices, const std::vector<unsigned int>& indices,
+        const glm::vec3& origin);
+
+    // Same, from arrays that need not be vectors (e.g. a memory-mapped cache)
+    MeshHandle allocate(const PackedVertex* vertices, std::size_t vertexCount,
+        const unsigned int* indices, std::size_t indexCount, const glm::vec3& origin);
+
+    // Returns the mesh's ranges to the free lists
+    void release(MeshHandle handle);
+
+    DrawRange range(MeshHandle handle) const;
+
+    // Bind once (flushes page table changes), then draw any number of meshes
+    void bind();
+    void draw(MeshHandle handle) const;
+    void submit(const DrawCommandList& list) const;
+
+    // Packs every live mesh to the front of fresh buffers of the same size
+    void defragment();
+
+    Stats stats() const;
+
+private:
+    struct Slot
+    {
+        std::size_t pageOffset, vertexCount;
+        std::size_t indexOffset, indexCount;
+        glm::vec3 origin;
+        bool live;
+    };
+
+    static std::size_t pagesFor(std::size_t vertexCount) { return (vertexCount + PAGE_VERTICES - 1) / PAGE_VERTICES; }
+
+    // Writes a slot's origin into its pages of the CPU page table
+    void writePages(const Slot& slot);
+
+    // Copies live meshes into new buffers of the given capacity, packed in slot order
+    void relocate(std::size_t pageCapacity, std::size_t indexCapacity);
+
+    // Makes room for a mesh of this size, compacting or growing as needed
+    void reserve(std::size_t pageCount, std::size_t indexCount);
+
+    // (Re)creates the page table buffer and texture for the current page capacity
+    void createPageTable();
+
+    ArenaBackend* backend;
+    unsigned vertexBuffer, indexBuffer, vertexArray;
+    unsigned pageBuffer, pageTexture;
+
+    RangeAllocator vertexRanges, indexRanges;   // Vertex ranges count pages
+    std::vector<glm::vec4> pageOrigins;         // Chunk origin per vertex page (xyz)
+    std::size_t dirtyBegin = 0, dirtyEnd = 0;   // Page range not yet uploaded
+    std::vector<Slot> slots;                    // slots[handle - 1]
+    std::vector<MeshHandle> freeSlots;
+
+    std::uint64_t growCount = 0, defragCount = 0, movedBytes = 0;
+};
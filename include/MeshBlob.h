@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Chunk.h"
+
+#define MESH_BLOB_VERSION 1      // Bump on any change to the header or payload layout
+#define MESH_BLOB_ALIGNMENT 16   // Payload alignment, from the start of the blob
+
+/* ------------------------- */
+/* MeshBlob: one chunk mesh as a self-checking block of bytes */
+/* [MeshBlobHeader][pad][PackedVertex x vertexCount][pad][uint32 x indexCount] */
+/* The payloads are the exact arrays MeshArena (and Mesh) upload, so a */
+/* validated blob goes from a mapped file to the GPU without a copy. */
+/* The checksum covers the header (with the checksum field zeroed) and */
+/* both payloads; padding is not covered */
+/* ------------------------- */
+struct MeshBlobHeader
+{
+    char magic[4];                // "TRMB"
+    std::uint16_t version;        // MESH_BLOB_VERSION
+    std::uint16_t vertexStride;   // sizeof(PackedVertex)
+    std::uint32_t vertexCount;
+    std::uint32_t indexCount;
+    std::uint32_t vertexOffset;   // Payload offsets from the start of the blob
+    std::uint32_t indexOffset;
+    std::uint64_t checksum;
+    Chunk::MeshInfo info;         // Index ranges and chunk-local bounds
+    std::uint32_t reserved;       // Zero; keeps the header free of implicit padding
+};
+
+static_assert(sizeof(MeshBlobHeader) == 96, "MeshBlobHeader layout changed: bump MESH_BLOB_VERSION");
+
+// A validated blob, read in place
+struct MeshBlobView
+{
+    const MeshBlobHeader* header = nullptr;
+    const PackedVertex* vertices = nullptr;
+    const unsigned int* indices = nullptr;
+
+    std::size_t vertexCount() const { return header->vertexCount; }
+    std::size_t indexCount() const { return header->indexCount; }
+
+    // Bytes of both payloads (what an upload moves)
+    std::size_t payloadBytes() const;
+};
+
+// Header for a blob of these arrays: offsets, counts and checksum filled in
+MeshBlobHeader makeMeshBlobHeader(const Chunk::MeshInfo& info,
+    const PackedVertex* vertices, std::size_t vertexCount,
+    const unsigned int* indices, std::size_t indexCount);
+
+// Total blob size for a header made by makeMeshBlobHeader
+std::size_t meshBlobBytes(const MeshBlobHeader& header);
+
+// Writes a whole blob into out (resized to meshBlobBytes; padding is zero)
+void serializeMeshBlob(const Chunk::MeshInfo& info,
+    const std::vector<PackedVertex>& vertices, const std::vector<unsigned int>& indices,
+    std::vector<unsigned char>& out);
+
+// Checks magic, version, stride, that both payloads lie inside bytes and
+// are aligned, and the checksum. On success out points into data
+bool readMeshBlob(const void* data, std::size_t bytes, MeshBlobView& out);
@@ -0,0 +1,100 @@
+#pragma once
+#include <atomic>
+#include <memory>
+
+/* ------------------------- */
+/* Intrusive hook for MpscQueue; payload types derive from it */
+/* ------------------------- */
+struct MpscNode
+{
+    std::atomic<MpscNode*> mpscNext{ nullptr };
+
+    MpscNode() = default;
+
+    // Copies never inherit queue linkage
+    MpscNode(const MpscNode&) : mpscNext(nullptr) {}
+    MpscNode& operator=(const MpscNode&) { return *this; }
+};
+
+/* ------------------------- */
+/* MpscQueue: lock-free multi-producer / single-consumer FIFO */
+/* Intrusive (Vyukov) design: push never allocates and payloads move */
+/* through by pointer, owned by unique_ptr on both ends. */
+/* push() may be called from any thread; pop() only from one */
+/* ------------------------- */
+template <typename T>
+class MpscQueue
+{
+public:
+    MpscQueue() : head(&stub), tail(&stub) {}
+
+    // Frees anything still queued
+    ~MpscQueue()
+    {
+        while (pop()) {}
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Producer side: takes ownership of item
+    void push(std::unique_ptr<T> item)
+    {
+        link(item.release());
+    }
+
+    // Consumer side: returns nullptr when empty (or when a push is mid-flight)
+    std::unique_ptr<T> pop()
+    {
+        MpscNode* first = tail;
+        MpscNode* next = first->mpscNext.load(std::memory_order_acquire);
+
+        // Skip the stub
+        if (first == &stub)
+        {
+            if (!next)
+                return nullptr;
+            tail = next;
+            first = next;
+            next = next->mpscNext.load(std::memory_order_acquire);
+        }
+
+        if (next)
+        {
+            tail = next;
+            return std::unique_ptr<T>(static_cast<T*>(first));
+        }
+
+        // A producer has swapped head but not linked yet; try again later
+        if (first != head.load(std::memory_order_acquire))
+            return nullptr;
+
+        // first is the last real node: re-insert the stub behind it so it can be detached
+        link(&stub);
+        next = first->mpscNext.load(std::memory_order_acquire);
+        if (next)
+        {
+            tail = next;
+            return std::unique_ptr<T>(static_cast<T*>(first));
+        }
+        return nullptr;
+    }
+
+    // Consumer-side hint; may miss in-flight pushes
+    bool empty() const
+    {
+        return tail == &stub && !stub.mpscNext.load(std::memory_order_acquire);
+    }
+
+private:
+    void link(MpscNode* node)
+    {
+        node->mpscNext.store(nullptr, std::memory_order_relaxed);
+        MpscNode* prev = head.exchange(node, std::memory_order_acq_rel);
+        prev->mpscNext.store(node, std::memory_order_release);
+    }
+
+    MpscNode stub;
+    alignas(64) std::atomic<MpscNode*> head;   // Producers swap here
+    alignas(64) MpscNode* tail;                // Consumer only
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+/* ------------------------- */
+/* Batched 2D OpenSimplex2 noise */
+/* Evaluates many points per call with SSE4.1 or AVX2, chosen at runtime */
+/* ------------------------- */
+
+// Instruction set used by simplex2Batch
+enum class SimdLevel
+{
+    Scalar, SSE41, AVX2
+};
+
+// Parameters of one noise layer, mirroring the FastNoiseLite settings
+// (OpenSimplex2, FractalType_None; octave settings have no effect)
+struct Simplex2Params
+{
+    int seed = 1337;          // FastNoiseLite default seed
+    float frequency = 0.01f;  // FastNoiseLite default frequency
+};
+
+// Best instruction set supported by this CPU (detected once)
+SimdLevel detectSimdLevel();
+
+// Human-readable name for logs and benchmarks
+const char* simdLevelName(SimdLevel level);
+
+// out[i] = FastNoiseLite::GetNoise(x[i], y[i]) for count points
+// Uses the best supported SIMD level. Results match the scalar FastNoiseLite
+// path bit for bit, as long as the compiler does not contract a*b+c into
+// FMA in either path (MSVC /fp:precise does not). If it does, they differ
+// by at most ~1e-6
+void simplex2Batch(const Simplex2Params& params,
+    const float* x, const float* y, float* out, int count);
+
+// Identifies the arithmetic behind simplex2Batch's results: 0 when every
+// SIMD level matches the scalar path bit for bit, else 1 + the level in use
+// (FMA contraction makes the levels differ). Folded into generatorKey, so
+// cached meshes never meet freshly built ones at a seam with other heights
+int noiseArithmetic();
+
+// Same as simplex2Batch but forces a specific SIMD level (must be supported)
+void simplex2BatchLevel(SimdLevel level, const Simplex2Params& params,
+    const float* x, const float* y, float* out, int count);
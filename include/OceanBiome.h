@@ -1,13 +1,19 @@
 #pragma once
 #include "Biome.h"
+#include "NoiseBatch.h"
 #include <FastNoiseLite.h>
 
 class OceanBiome : public Biome
 {
     FastNoiseLite floorNoise;
+    Simplex2Params floorParams;     // floorNoise settings for batched sampling
     float waterLevel;
+
+    float heightFromNoise(float floor) const;
 public:
-    OceanBiome(float voxelScale, float waterLevelWorld);
+    OceanBiome(float voxelScale, float waterLevelWorld, int seed);
     float getHeight(float wx, float wz) const override;
+    void getHeights(const float* wx, const float* wz, float* out, int count) const override;
     glm::vec3 getSurfaceColor(float wy) const override;
+    void hashParams(std::uint64_t& h) const override;
 };
\ No newline at end of file
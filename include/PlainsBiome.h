@@ -1,13 +1,19 @@
 #pragma once
 #include "Biome.h"
+#include "NoiseBatch.h"
 #include <FastNoiseLite.h>
 
 class PlainsBiome : public Biome
 {
     FastNoiseLite continental, hills, detail;
+    Simplex2Params continentalParams, hillsParams, detailParams;  // For batched sampling
     float waterLevel;
+
+    float heightFromNoise(float continentalN, float detailN, float hillN) const;
 public:
-    PlainsBiome(float voxelScale, float waterLevelWorld);
+    PlainsBiome(float voxelScale, float waterLevelWorld, int seed);
     float getHeight(float wx, float wz) const override;
+    void getHeights(const float* wx, const float* wz, float* out, int count) const override;
     glm::vec3 getSurfaceColor(float wy) const override;
+    void hashParams(std::uint64_t& h) const override;
 };
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include "MeshArena.h"
+
+/* ------------------------- */
+/* RecordingArenaBackend: a null GPU that only counts */
+/* Buffers have a size but no storage, so a World can stream and draw */
+/* without a GL context (tests, benchmarks, CI hosts) at no memory cost. */
+/* Every call is tallied: bytes created, uploaded and copied, draw calls */
+/* and binding changes. Out-of-range uploads, copies and draws are */
+/* flagged the same way the real buffers would reject them */
+/* ------------------------- */
+class RecordingArenaBackend : public ArenaBackend
+{
+public:
+    struct Counters
+    {
+        std::uint64_t buffersCreated = 0;
+        std::uint64_t bufferBytesCreated = 0;   // Sum of createBuffer sizes
+        std::uint64_t uploads = 0;
+        std::uint64_t bytesUploaded = 0;
+        std::uint64_t copies = 0;               // GPU-side copies (arena growth and compaction)
+        std::uint64_t bytesCopied = 0;
+        std::uint64_t drawCalls = 0;            // Submissions; a multi-draw counts once
+        std::uint64_t rangesDrawn = 0;          // Index ranges those calls covered
+        std::uint64_t trianglesDrawn = 0;
+        std::uint64_t stateChanges = 0;         // Binds that changed the bound vertex array or texture
+        std::uint64_t redundantBinds = 0;       // Binds of what was already bound
+        std::uint64_t errors = 0;               // Out-of-range or unknown-object calls
+    };
+
+    unsigned createBuffer(BufferKind kind, std::size_t bytes) override;
+    void destroyBuffer(unsigned buffer) override;
+    void uploadBuffer(unsigned buffer, std::size_t offset, const void* data, std::size_t bytes) override;
+    void copyBuffer(unsigned src, std::size_t srcOffset, unsigned dst, std::size_t dstOffset, std::size_t bytes) override;
+
+    unsigned createVertexArray(unsigned vertexBuffer, unsigned indexBuffer) override;
+    void destroyVertexArray(unsigned vertexArray) override;
+
+    unsigned createBufferTexture(unsigned buffer) override;
+    void destroyTexture(unsigned texture) override;
+    void bindBufferTexture(unsigned texture) override;
+
+    void bindVertexArray(unsigned vertexArray) override;
+    void drawElementsBaseVertex(unsigned indexCount, std::size_t firstIndex, int baseVertex) override;
+    void multiDraw(const DrawCommandList& list) override;
+
+    const Counters& counters() const { return totals; }
+    void resetCounters() { totals = Counters(); }
+
+    // Bytes of every buffer not yet destroyed (what the GPU would hold)
+    std::uint64_t liveBufferBytes() const { return liveBytes; }
+
+private:
+    struct VertexArray
+    {
+        unsigned vertexBuffer, indexBuffer;
+    };
+
+    // Size of a live buffer, or 0 (and an error) if there is none
+    std::size_t bufferSize(unsigned buffer);
+
+    // Counts a draw and checks it against the bound vertex array
+    void checkDraw(unsigned indexCount, std::size_t firstIndex, int baseVertex);
+
+    std::unordered_map<unsigned, std::size_t> buffers;          // Buffer -> size
+    std::unordered_map<unsigned, VertexArray> vertexArrays;
+    std::unordered_map<unsigned, unsigned> textures;            // Texture -> buffer
+    unsigned nextId = 1;
+    unsigned boundVertexArray = 0, boundTexture = 0;
+    std::uint64_t liveBytes = 0;
+    Counters totals;
+};
@@ -0,0 +1,117 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Chunk.h"
+#include "MeshBlob.h"
+#include "Vec2Hash.h"
+
+#define REGION_SIZE 32   // Chunks per region side
+#define REGION_CACHE_DIR "region_cache"   // World's cache, relative to the working directory
+
+class RegionFile;
+struct RegionMapping;
+
+/* ------------------------- */
+/* CachedMesh: a chunk mesh read in place from a mapped region file */
+/* Holds the mapping open, so the arrays stay valid as long as the view */
+/* does, however the cache changes meanwhile */
+/* ------------------------- */
+class CachedMesh
+{
+public:
+    bool valid() const { return blob.header != nullptr; }
+
+    const Chunk::MeshInfo& info() const;
+    const PackedVertex* vertices() const;
+    const unsigned int* indices() const;
+    std::size_t vertexCount() const;
+    std::size_t indexCount() const;
+
+    // Bytes of the vertex and index arrays
+    std::size_t bytes() const;
+
+private:
+    friend class RegionCache;
+
+    std::shared_ptr<const RegionMapping> mapping;
+    MeshBlobView blob;
+};
+
+/* ------------------------- */
+/* RegionCache: generated chunk meshes on disk */
+/* One file per REGION_SIZE x REGION_SIZE chunks: a header, an index of */
+/* (offset, size) per chunk and LOD, then the records. A record is a */
+/* MeshBlob: the chunk's MeshInfo and its vertex and index arrays exactly */
+/* as they are uploaded, so a hit is a checksummed pointer into the */
+/* mapped file. A record that fails validation is a miss. */
+/* Files carry a key of the generator parameters and the mesh format; */
+/* a file with any other key is stale and is emptied when opened. */
+/* Thread-safe; records are appended, never rewritten */
+/* ------------------------- */
+class RegionCache
+{
+public:
+    struct Stats
+    {
+        std::uint64_t hits = 0;            // load() calls that found a record
+        std::uint64_t misses = 0;          // load() calls that did not
+        std::uint64_t stores = 0;          // Records appended
+        std::uint64_t bytesWritten = 0;    // Record bytes appended
+        std::uint64_t staleRegions = 0;    // Files discarded for a different key
+        std::uint64_t corruptRecords = 0;  // Records that failed validation (counted as misses)
+    };
+
+    // Region files go in directory (created if missing). generatorKey is
+    // BiomeManager::generatorKey(); the mesh layout is folded in here
+    RegionCache(const std::string& directory, std::uint64_t generatorKey);
+    ~RegionCache();
+
+    RegionCache(const RegionCache&) = delete;
+    RegionCache& operator=(const RegionCache&) = delete;
+
+    // The cached mesh of chunk pos at lod; false when there is none.
+    // An empty chunk is a valid entry with no vertices
+    bool load(glm::ivec2 pos, int lod, CachedMesh& out);
+
+    // Appends a chunk's mesh; a later store of the same chunk and LOD wins
+    void store(glm::ivec2 pos, int lod, const Chunk::MeshInfo& info,
+        const std::vector<PackedVertex>& vertices, const std::vector<unsigned int>& indices);
+
+    Stats stats() const;
+
+    // File holding a region's chunks
+    static std::string regionPath(const std::string& directory, glm::ivec2 region);
+
+    // Region holding a chunk, and the chunk's slot in that region's index
+    static glm::ivec2 regionOf(glm::ivec2 pos);
+    static int slotOf(glm::ivec2 pos, int lod);
+
+private:
+    struct OpenRegion
+    {
+        std::shared_ptr<RegionFile> file;
+        std::uint64_t lastUse;
+    };
+
+    // The open region file, opening it on first use (null if it cannot be opened)
+    std::shared_ptr<RegionFile> region(glm::ivec2 coord);
+
+    // Opens a region file, emptying it if it is missing, damaged or stale
+    std::shared_ptr<RegionFile> openRegion(glm::ivec2 coord);
+
+    std::string directory;
+    std::uint64_t key;
+
+    std::mutex regionMutex;   // Guards regions and useClock
+    std::unordered_map<glm::ivec2, OpenRegion, Vec2Hash> regions;
+    std::uint64_t useClock = 0;
+
+    std::atomic<std::uint64_t> hitCount{ 0 }, missCount{ 0 }, storeCount{ 0 };
+    std::atomic<std::uint64_t> writtenBytes{ 0 }, staleCount{ 0 }, corruptCount{ 0 };
+};
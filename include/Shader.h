@@ -13,6 +13,8 @@ public:
 
     void setMat4(const std::string& name, const glm::mat4& mat) const;
     void setVec3(const std::string& name, const glm::vec3& vec) const;
+    void setFloat(const std::string& name, float value) const;
+    void setInt(const std::string& name, int value) const;
 private:
     GLuint ID;
 
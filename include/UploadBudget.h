@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/* ------------------------- */
+/* UploadBudget: per-frame time budget for GPU mesh uploads */
+/* Predicts the cost of an upload as fixed + perByte * bytes and refits */
+/* both terms from measured upload times (exponentially weighted least */
+/* squares), so the finalizer adapts to the driver it is running on */
+/* ------------------------- */
+class UploadBudget
+{
+public:
+    // Overrun bookkeeping, readable by the main loop
+    struct Stats
+    {
+        std::uint64_t frames = 0;           // Frames that uploaded anything
+        std::uint64_t uploads = 0;          // Meshes uploaded
+        std::uint64_t overrunFrames = 0;    // Frames that exceeded the budget
+        double lastFrameMicros = 0.0;       // Upload time spent in the last frame
+        double worstOverrunMicros = 0.0;    // Largest amount over budget so far
+    };
+
+    explicit UploadBudget(double budgetMicros);
+
+    void setBudget(double micros) { budgetMicros = micros; }
+    double budget() const { return budgetMicros; }
+
+    // Predicted upload time for a mesh of the given size
+    double estimate(std::size_t bytes) const;
+
+    // Frame protocol: beginFrame, then canAfford/record per upload, then endFrame
+    void beginFrame();
+
+    // True if the upload fits in what is left of this frame's budget.
+    // The first upload of a frame is always allowed so large meshes still progress
+    bool canAfford(std::size_t bytes) const;
+
+    // Charge a measured upload to this frame and refine the cost model
+    void record(std::size_t bytes, double micros);
+
+    // Returns true if this frame went over budget
+    bool endFrame();
+
+    const Stats& stats() const { return frameStats; }
+
+    // Current model terms, for diagnostics
+    double fixedMicros() const { return fixedCost; }
+    double microsPerKB() const { return perByteCost * 1024.0; }
+
+private:
+    void refit();
+
+    double budgetMicros;
+    double spentMicros = 0.0;               // Charged this frame
+    int uploadsThisFrame = 0;
+
+    // Cost model, seeded with a conservative guess until measurements arrive
+    double fixedCost = 150.0;               // Fitted per-upload intercept in microseconds, seeded at 150
+    double perByteCost = 1.0 / 1024.0;      // Fitted microseconds per byte, seeded at ~1 us per KB
+
+    // Decayed sums for the least-squares fit of micros = fixed + perByte * bytes
+    double sumW = 0.0, sumX = 0.0, sumY = 0.0, sumXX = 0.0, sumXY = 0.0;
+
+    Stats frameStats;
+};
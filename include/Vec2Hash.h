@@ -0,0 +1,19 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+
+/* ------------------------------------------------------------ */
+/* Hash for glm::ivec2 keys (chunk, tile and region coordinates) */
+/* in unordered_map */
+/* ------------------------------------------------------------ */
+struct Vec2Hash
+{
+    std::size_t operator()(const glm::ivec2& v) const
+    {
+        // Multiply both coordinates so (x,z), (z,x) and (-x,-z) do not collide
+        std::uint64_t h = std::uint64_t(std::uint32_t(v.x)) * 0x9E3779B97F4A7C15ull
+            ^ std::uint64_t(std::uint32_t(v.y)) * 0xC2B2AE3D27D4EB4Full;
+        return std::size_t(h ^ (h >> 29));
+    }
+};
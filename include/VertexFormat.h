@@ -0,0 +1,34 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstdint>
+
+/* ------------------------- */
+/* Vertex quantization settings */
+/* ------------------------- */
+#define POSITION_STEPS_PER_UNIT 128   // 16-bit positions: 1/128 world unit, up to 511.99 units per axis
+
+/* ------------------------- */
+/* PackedVertex: 12-byte interleaved terrain vertex */
+/* Position is chunk-local and quantized; the chunk origin is added in */
+/* the vertex shader. Normals are octahedral-encoded in two snorm8s */
+/* ------------------------- */
+struct PackedVertex
+{
+    std::uint16_t position[3];   // Chunk-local position * POSITION_STEPS_PER_UNIT
+    std::int8_t normal[2];       // Octahedral normal, snorm8
+    std::uint8_t color[4];       // RGBA8, alpha = 255
+};
+
+static_assert(sizeof(PackedVertex) == 12, "PackedVertex must stay tightly packed");
+
+// Quantizes one vertex; localPos must lie in [0, 65535 / POSITION_STEPS_PER_UNIT]
+PackedVertex packVertex(const glm::vec3& localPos, const glm::vec3& normal, const glm::vec3& color);
+
+// Inverse of packVertex, matching the decode in mc.vert
+glm::vec3 unpackPosition(const PackedVertex& v);
+glm::vec3 unpackNormal(const PackedVertex& v);
+glm::vec3 unpackColor(const PackedVertex& v);
+
+// Octahedral mapping of a unit vector to [-1, 1]^2 and back
+glm::vec2 octEncode(const glm::vec3& n);
+glm::vec3 octDecode(const glm::vec2& p);
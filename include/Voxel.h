@@ -306,6 +306,15 @@ static const int edgeVertexIndices[12][2] = {
     {0, 4}, {1, 5}, {2, 6}, {3, 7}  // Vertical edges
 };
 
+// Add edgeLattice: Maps each of 12 edges to the lattice edge it lies on as
+// {dx, dy, dz, axis}: lower corner offset from the cube origin and the axis
+// (0 = x, 1 = y, 2 = z) it runs along. Neighbouring cubes share lattice edges
+static const int edgeLattice[12][4] = {
+    {0, 0, 0, 0}, {1, 0, 0, 2}, {0, 0, 1, 0}, {0, 0, 0, 2}, // Bottom face edges
+    {0, 1, 0, 0}, {1, 1, 0, 2}, {0, 1, 1, 0}, {0, 1, 0, 2}, // Top face edges
+    {0, 0, 0, 1}, {1, 0, 0, 1}, {1, 0, 1, 1}, {0, 0, 1, 1}  // Vertical edges
+};
+
 // Add vertexOffsets: 3D offsets for 8 cube corners
 static const glm::vec3 vertexOffsets[8] = {
     glm::vec3(0.0f, 0.0f, 0.0f), // Corner 0
@@ -2,51 +2,123 @@
 
 #include <glm/glm.hpp>
 #include <unordered_map>
-#include <queue>
 #include <vector>
-#include <thread>
 #include <mutex>
-#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <string>
 #include "Chunk.h"
+#include "HeightTileCache.h"
+#include "JobSystem.h"
+#include "MpscQueue.h"
+#include "UploadBudget.h"
+#include "MeshArena.h"
+#include "DrawCommandList.h"
+#include "ChunkQuadtree.h"
+#include "FrustumCuller.h"
+#include "ChunkGrid.h"
+#include "RegionCache.h"
+#include "Vec2Hash.h"
 
-/* ------------------------------------------------------------ */
-/* Custom hash function for glm::ivec2 to use in unordered_map */
-/* ------------------------------------------------------------ */
-struct Vec2Hash
-{
-    std::size_t operator()(const glm::ivec2& v) const
-    {
-        return std::hash<int>()(v.x) ^ (std::hash<int>()(v.y) << 1);
-    }
-};
+#define LOAD_RADIUS 24          // Chunks generated this many rings around the camera
+#define UNLOAD_RADIUS 26        // Loaded chunks kept this far; the gap absorbs back-and-forth moves
 
 /* ------------------------------------------- */
 /* Data container for completed chunk mesh data */
+/* Heap-allocated once per chunk and handed to the main thread by */
+/* pointer; the copy constructor exists only to be counted */
 /* ------------------------------------------- */
-struct ChunkData
+struct ChunkData : MpscNode
 {
     glm::ivec2 pos;                          // Chunk position (grid coords)
-    Chunk* chunk;                           // Pointer to the chunk object
-    std::vector<glm::vec3> vertices;       // Mesh vertex positions
-    std::vector<glm::vec3> colors;         // Vertex colors
-    std::vector<glm::vec3> normals;        // Vertex normals
+    Chunk* chunk = nullptr;                 // Pointer to the chunk object
+    std::vector<PackedVertex> vertices;    // Packed, chunk-local mesh vertices
     std::vector<unsigned int> indices;     // Triangle indices
+    CachedMesh cached;                      // Mesh read from the region cache instead (arrays above stay empty)
     bool hasMesh = false;                   // True if mesh data is valid
+
+    ChunkData();
+    ChunkData(const ChunkData& other);      // Adds meshBytes() to the copy counter
+    ChunkData& operator=(const ChunkData&) = delete;
+
+    // CPU-side size of the mesh arrays (or of the cached mesh)
+    std::size_t meshBytes() const;
 };
 
 /* -------------------------------------------- */
-/* Task struct used for chunk loading prioritization */
+/* Counters for the worker -> main thread mesh hand-off */
 /* -------------------------------------------- */
+struct MeshHandoffStats
+{
+    std::uint64_t payloadsAllocated = 0;   // ChunkData objects created
+    std::uint64_t bytesHandedOff = 0;      // Mesh bytes passed to the main thread
+    std::uint64_t bytesCopied = 0;         // Mesh bytes duplicated on the way (expected 0)
+};
+
+/* -------------------------------------------- */
+/* Generation state of a chunk that is not in World::chunks yet */
+/* -------------------------------------------- */
+enum class ChunkTaskState
+{
+    Queued,         // Job submitted, not started
+    Generating,     // A worker is building it
+    Done            // Built; waiting for finalize (or known to be empty)
+};
+
 struct ChunkTask
 {
-    glm::ivec2 pos;     // Chunk position to process
-    float distance;     // Distance from camera (priority key)
+    ChunkTaskState state;
+    unsigned ticket;    // Bumped when re-prioritised; jobs with an old ticket exit early
+    int priority;       // Current JobSystem priority bucket
+    int lod;            // Level to build; re-scored while queued, read when claimed
+};
 
-    // Priority comparison: smaller distance = higher priority
-    bool operator<(const ChunkTask& other) const
-    {
-        return distance > other.distance;
-    }
+/* -------------------------------------------- */
+/* Counters for chunk streaming efficiency */
+/* -------------------------------------------- */
+struct StreamingStats
+{
+    std::uint64_t generated = 0;           // Chunks built by workers
+    std::uint64_t wasted = 0;              // Built, then discarded without being drawn
+    std::uint64_t cancelled = 0;           // Queued tasks dropped before running
+    std::uint64_t duplicatesSkipped = 0;   // Re-queues avoided for pending chunks
+    std::uint64_t reprioritised = 0;       // Tasks moved to a different priority bucket
+};
+
+/* -------------------------------------------- */
+/* Streaming latency probe (WorldConfig::latencyProbe), refilled every */
+/* frame. Latencies run from the update that queued a chunk entering the */
+/* load window; a hole is a chunk in that window and in view that is */
+/* neither drawn nor known to be empty */
+/* -------------------------------------------- */
+struct StreamingProbe
+{
+    std::vector<double> uploadLatency;   // Seconds, per chunk uploaded by the last update()
+    std::vector<double> drawLatency;     // Seconds, per chunk the last submitDraws() drew for the first time
+    std::uint32_t holes = 0;             // Holes in the last submitDraws()
+};
+
+/* -------------------------------------------- */
+/* What a World is built on. The defaults are the game's; a headless */
+/* World (tests, benchmarks) passes a RecordingArenaBackend and a */
+/* simulated clock, and usually no region cache */
+/* -------------------------------------------- */
+struct WorldConfig
+{
+    int seed = DEFAULT_TERRAIN_SEED;          // Terrain; the region cache keeps each seed's chunks apart
+    ArenaBackend* backend = nullptr;          // Not owned; null creates a GlArenaBackend on the current context
+    std::function<double()> clock;            // Seconds; empty uses the steady clock from construction
+    std::string regionCacheDir = REGION_CACHE_DIR;   // Empty disables the on-disk cache
+    int workerThreads = 0;                    // 0 = hardware concurrency
+    bool latencyProbe = false;                // Fill streamingProbe() (per-chunk bookkeeping every frame)
+    bool ringDiffStreaming = true;            // false rescans the whole window whenever the camera changes chunk
+
+    // Streaming window, in chunk rings. unloadRadius below loadRadius is
+    // raised to it; LOD bands must be more than 2 rings wide (twice the
+    // hysteresis) so neighbouring chunks stay within one level
+    int loadRadius = LOAD_RADIUS;
+    int unloadRadius = UNLOAD_RADIUS;
+    int lodRadius[LOD_LEVELS - 1] = { 4, 8, 16 };   // Outermost ring of each LOD but the last
 };
 
 /* ------------------- */
@@ -55,7 +127,7 @@ struct ChunkTask
 class World
 {
 public:
-    World();
+    explicit World(const WorldConfig& config = WorldConfig());
     ~World();
 
     // Update world state, loading/unloading chunks as needed
@@ -67,40 +139,126 @@ public:
         const glm::mat4& view,
         const glm::mat4& projection);
 
-    // Map of chunk positions to chunk pointers
-    std::unordered_map<glm::ivec2, Chunk*, Vec2Hash> chunks;
+    // The backend half of draw(): cull, build the command list and submit
+    // it through the arena backend. draw() is this plus the shader uniform
+    void submitDraws(const glm::mat4& viewProj);
+
+    // Blocks until every queued chunk job has run, so a headless caller
+    // can step the world without racing the workers
+    void waitForWorkers();
+
+    // CPU stage of draw(): each visible chunk's mesh, plus its transition
+    // strips towards finer neighbours, as multi-draw commands; no GL calls
+    void buildDrawCommands(const glm::mat4& viewProj, DrawCommandList& list);
+
+    // Commands submitted by the last draw() (draw, culled and triangle counts)
+    const DrawCommandList& lastDrawList() const { return drawList; }
+
+    // Loaded chunks in a toroidal grid around the camera
+    ChunkGrid chunks;
+
+    // Shared heightmap tiles (hit/miss counters for diagnostics)
+    const HeightTileCache& tileCache() const { return *heightTiles; }
+
+    // Snapshot of the streaming counters
+    StreamingStats streamingStats();
+
+    // Snapshot of the mesh hand-off counters (process-wide)
+    static MeshHandoffStats meshHandoffStats();
+
+    // Per-frame GPU upload budget (set the budget, read overrun stats)
+    UploadBudget& finalizeBudget() { return uploadBudget; }
+
+    // Occupancy and fragmentation of the shared mesh buffers
+    MeshArena::Stats meshArenaStats() const { return meshArena->stats(); }
+
+    // Latencies and holes of the last frame (empty unless WorldConfig::latencyProbe)
+    const StreamingProbe& streamingProbe() const { return probe; }
+
+    // Wall time of the last window scan: the queue, unload and LOD passes
+    // of an update() that changed camera chunk, without the job hand-off
+    double lastScanSeconds() const { return scanSeconds; }
+
+    // Hits, misses and writes of the on-disk chunk cache (zero when disabled)
+    RegionCache::Stats regionCacheStats() const { return regionCache ? regionCache->stats() : RegionCache::Stats(); }
 
 private:
     BiomeManager* biomeMgr;
+    HeightTileCache* heightTiles;           // Column samples shared by all workers
+    RegionCache* regionCache;               // Meshes of chunks generated before, on disk (null if disabled)
+
+    ArenaBackend* arenaBackend;              // GL calls used by the mesh arena
+    bool ownsBackend;                        // Created here rather than passed in the config
+    std::function<double()> clock;          // Seconds; drives the update rate limit and upload timing
+    MeshArena* meshArena;                   // Vertex/index buffers shared by all chunk meshes
+    DrawCommandList drawList;               // Rebuilt every frame by draw()
+    ChunkQuadtree chunkTree;                // Loaded chunks with height bounds, for culling and unload queries
+    FrustumCuller culler;                   // Mesh bounds of loaded chunks, keyed by mesh handle (flat SIMD culling)
+    std::vector<std::uint32_t> visibleMeshes;   // Culling output, reused every frame
+    std::vector<Chunk*> meshChunks;         // Chunk owning each live mesh handle (stale for freed handles)
 
     glm::ivec2 lastCameraChunk;            // Last chunk the camera was in
-    float lastUpdateTime = 0.0f;           // Time of last update call
+    double lastUpdateTime = 0.0;           // Time of last update call
+    bool ringDiff;                         // WorldConfig::ringDiffStreaming
+    int loadRadius;                        // WorldConfig window radii and LOD bands
+    int unloadRadius;
+    int lodRadius[LOD_LEVELS - 1];
+    double scanSeconds = 0.0;              // lastScanSeconds()
+
+    JobSystem* jobs;                          // Worker pool for background chunk generation
 
-    std::priority_queue<ChunkTask> taskQueue; // Chunk processing tasks queue
-    std::mutex taskMutex;                     // Mutex for task queue
-    std::condition_variable taskCondition;   // Condition variable to wake worker threads
+    // Chunks queued, generating or awaiting finalize, for O(1) de-duplication
+    std::unordered_map<glm::ivec2, ChunkTask, Vec2Hash> tasks;
+    std::mutex taskMutex;                     // Guards tasks and stats
+    StreamingStats stats;
 
-    std::vector<std::thread> workers;         // Worker threads for background chunk generation
-    bool running = true;                       // Worker thread run control flag
+    MpscQueue<ChunkData> completedChunks;     // Chunks completed by workers (lock-free)
+    std::vector<std::unique_ptr<ChunkData>> readyChunks;   // Popped but over budget; finalized in later frames
 
-    std::queue<ChunkData> completedChunks;    // Queue of chunks completed by workers
-    std::mutex completedMutex;                 // Mutex for completed chunks queue
+    UploadBudget uploadBudget;                // Time allowed for chunk finalization per frame
 
-    const int maxFinalizePerFrame = 30;       // Max chunks finalized per frame
+    // Latency probe: chunks that entered the load window and are not drawn yet
+    struct PendingChunk
+    {
+        double entered;     // clock() of the update that queued it
+        bool uploaded;      // Upload latency already recorded
+    };
+    bool probeEnabled;
+    std::unordered_map<glm::ivec2, PendingChunk, Vec2Hash> pendingChunks;
+    StreamingProbe probe;
+
+    // Probe half of submitDraws(): first-draw latencies and holes
+    void probeFrame(const Frustum& frustum);
+
+    // Nearer rings go into more urgent priority buckets
+    int chunkPriority(const glm::ivec2& pos, const glm::ivec2& centerChunk) const;
 
-    // Add chunks near the camera to the processing queue
-    void queueChunks(const glm::ivec2& centerChunk, const glm::vec3& cameraPos);
+    // LOD a chunk at this ring distance is built with
+    int lodForDistance(int distance) const;
+
+    // True while a chunk built at lod may stay at this distance
+    bool lodAcceptable(int lod, int distance) const;
+
+    // Add chunks near the camera to the processing queue; their jobs go into batch
+    // fullScan visits the whole window, otherwise only what entered it since lastCameraChunk
+    void queueChunks(const glm::ivec2& centerChunk, bool fullScan, std::vector<JobSystem::PrioritizedJob>& batch);
 
     // Unload chunks far from the camera
-    void unloadChunks(const glm::ivec2& centerChunk);
+    // fullScan queries every loaded chunk, otherwise only the strips that left the window
+    void unloadChunks(const glm::ivec2& centerChunk, bool fullScan);
+
+    // Queue rebuilds (into batch) for loaded chunks whose LOD the move made unacceptable
+    // fullScan checks every loaded chunk, otherwise only the rings a move can affect
+    void updateLods(const glm::ivec2& centerChunk, bool fullScan, std::vector<JobSystem::PrioritizedJob>& batch);
 
-    // Worker thread function: processes chunk generation tasks
-    void workerThread();
+    // Job body: generates one chunk's mesh data on a worker thread
+    // Returns early if the task was cancelled or re-queued under a newer ticket
+    void generateChunk(glm::ivec2 pos, unsigned ticket);
 
     // Finalize and upload chunk mesh data from completed chunks
     void processCompletedChunks();
 
-    // Frustum culling helper to check if chunk is visible
-    bool isChunkInFrustum(const glm::ivec2& pos,
-        const glm::mat4& viewProj);
+    // Keep chunkTree and culler in step with the loaded chunks
+    void addBounds(const Chunk* chunk);
+    void removeBounds(const Chunk* chunk);
 };
\ No newline at end of file
@@ -1,7 +1,7 @@
 #version 330 core
-layout(location = 0) in vec3 aPos;
-layout(location = 1) in vec3 aColor;
-layout(location = 2) in vec3 aNormal;
+layout(location = 0) in vec3 aPos;      // Chunk-local, quantized (see VertexFormat.h)
+layout(location = 1) in vec4 aColor;    // RGBA8
+layout(location = 2) in vec2 aNormal;   // Octahedral, snorm8 steps
 
 out vec3 FragPos;
 out vec3 Normal;
@@ -11,11 +11,28 @@ uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 
+uniform samplerBuffer chunkOrigins;   // Chunk origin per MeshArena vertex page
+uniform float positionScale;          // 1 / POSITION_STEPS_PER_UNIT
+
+const int PAGE_VERTICES = 256;        // MeshArena::PAGE_VERTICES
+
+vec3 octDecode(vec2 p)
+{
+    vec3 n = vec3(p, 1.0 - abs(p.x) - abs(p.y));
+    float t = max(-n.z, 0.0);
+    n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+    return normalize(n);
+}
+
 void main()
 {
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
-    Color = aColor;
+    // gl_VertexID includes the draw's base vertex, so it addresses the arena page
+    vec3 chunkOrigin = texelFetch(chunkOrigins, gl_VertexID / PAGE_VERTICES).xyz;
+    vec3 worldPos = chunkOrigin + aPos * positionScale;
+
+    FragPos = vec3(model * vec4(worldPos, 1.0));
+    Normal = mat3(transpose(inverse(model))) * octDecode(aNormal / 127.0);
+    Color = aColor.rgb;
 
     gl_Position = projection * view * vec4(FragPos, 1.0);
 }
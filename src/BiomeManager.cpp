@@ -1,27 +1,38 @@
 ﻿#include "../include/BiomeManager.h"
 #include "../include/Chunk.h"
+#include <vector>
 
 static constexpr float LAND_BIAS = 0.0f;
 
-BiomeManager::BiomeManager(float scale, float water)
+// Bump whenever a height, mask or colour formula changes; generatorKey
+// cannot see code, only parameters (each biome hashes its own)
+#define GENERATOR_VERSION 2
+
+// Biome mask noise settings at voxelScale 1, shared with generatorKey
+static constexpr float MASK_FREQUENCY = 0.00025f;
+static constexpr int MASK_OCTAVES = 5;
+static constexpr float MASK_LACUNARITY = 3.0f;
+static constexpr float MASK_GAIN = 0.2f;
+
+BiomeManager::BiomeManager(float scale, float water, int seed)
+    : voxelScale(scale), waterLevel(water)
 {
+    biomeNoise.SetSeed(seed);
     biomeNoise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
-    biomeNoise.SetFrequency(0.00025f / scale);          // gigantic continents
-    biomeNoise.SetFractalOctaves(5);
-    biomeNoise.SetFractalLacunarity(3);
-    biomeNoise.SetFractalGain(0.2f);
+    biomeNoise.SetFrequency(MASK_FREQUENCY / scale);    // gigantic continents
+    biomeNoise.SetFractalOctaves(MASK_OCTAVES);
+    biomeNoise.SetFractalLacunarity(MASK_LACUNARITY);
+    biomeNoise.SetFractalGain(MASK_GAIN);
+    biomeParams.frequency = MASK_FREQUENCY / scale;
+    biomeParams.seed = seed;
 
-    plains = std::make_unique<PlainsBiome>(scale, water);
-    ocean = std::make_unique<OceanBiome >(scale, water);
+    plains = std::make_unique<PlainsBiome>(scale, water, seed);
+    ocean = std::make_unique<OceanBiome >(scale, water, seed);
 }
 
-BiomeSample BiomeManager::sample(float wx, float wz) const
+BiomeSample BiomeManager::blend(float mask, float hOcean, float hPlains)
 {
-    float mask = biomeNoise.GetNoise(wx, wz);          // [-1..1]
     float t = glm::smoothstep(-1.0f, 0.0f, mask + LAND_BIAS);      // mask weight
-
-    float hOcean = ocean->getHeight(wx, wz);
-    float hPlains = plains->getHeight(wx, wz);
     float h = glm::mix(hOcean, hPlains, t);
 
     /* If final height is below water, force ocean weight to 1.0 */
@@ -30,6 +41,34 @@ BiomeSample BiomeManager::sample(float wx, float wz) const
     return { h, oceanWeight };
 }
 
+BiomeSample BiomeManager::sample(float wx, float wz) const
+{
+    float mask = biomeNoise.GetNoise(wx, wz);          // [-1..1]
+
+    return blend(mask, ocean->getHeight(wx, wz), plains->getHeight(wx, wz));
+}
+
+void BiomeManager::sampleGrid(glm::vec2 origin, float step, int nx, int nz, BiomeSample* out) const
+{
+    const int count = nx * nz;
+    std::vector<float> wx(count), wz(count), mask(count), hOcean(count), hPlains(count);
+
+    for (int x = 0; x < nx; ++x)
+        for (int z = 0; z < nz; ++z)
+        {
+            wx[x * nz + z] = origin.x + x * step;
+            wz[x * nz + z] = origin.y + z * step;
+        }
+
+    // Each noise layer runs over the whole grid at once to fill SIMD lanes
+    simplex2Batch(biomeParams, wx.data(), wz.data(), mask.data(), count);
+    ocean->getHeights(wx.data(), wz.data(), hOcean.data(), count);
+    plains->getHeights(wx.data(), wz.data(), hPlains.data(), count);
+
+    for (int i = 0; i < count; ++i)
+        out[i] = blend(mask[i], hOcean[i], hPlains[i]);
+}
+
 bool BiomeManager::nearOcean(float wx, float wz) const
 {
     const float step = 4.0f * VOXEL_SIZE;  // how far to sample
@@ -46,7 +85,7 @@ bool BiomeManager::nearOcean(float wx, float wz) const
     return false;
 }
 
-glm::vec3 BiomeManager::blendedSurfaceColor(float wy, float oceanW, float wx, float wz) const
+glm::vec3 BiomeManager::surfaceColor(float wy, float oceanW, bool nearOcean) const
 {
     const float solidSandStart = WATER_LEVEL_WORLD - 0.1f * VOXEL_SIZE;
     const float solidSandEnd = WATER_LEVEL_WORLD + 2.0f * VOXEL_SIZE;  // solid beach
@@ -55,7 +94,7 @@ glm::vec3 BiomeManager::blendedSurfaceColor(float wy, float oceanW, float wx, fl
     glm::vec3 sand = { 0.93f, 0.85f, 0.55f };
     glm::vec3 grass = plains->getSurfaceColor(wy);
 
-    if (nearOcean(wx, wz))
+    if (nearOcean)
     {
         if (wy >= solidSandStart && wy < solidSandEnd)
         {
@@ -75,3 +114,23 @@ glm::vec3 BiomeManager::blendedSurfaceColor(float wy, float oceanW, float wx, fl
         plains->getSurfaceColor(wy),
         1.f - oceanW);
 }
+
+/* ------------------------- */
+/* FNV-1a over the terrain constants, the mask noise settings and every */
+/* biome's noise settings, and the arithmetic the noise ran with */
+/* ------------------------- */
+std::uint64_t BiomeManager::generatorKey() const
+{
+    std::uint64_t h = 0xCBF29CE484222325ull;
+
+    const int constants[] = { GENERATOR_VERSION, CHUNK_HEIGHT, VOXEL_SIZE,
+        BASE_HEIGHT_WORLD, HEIGHT_VARIATION_WORLD, WATER_LEVEL_WORLD, biomeParams.seed, MASK_OCTAVES,
+        noiseArithmetic() };
+    const float parameters[] = { voxelScale, waterLevel, LAND_BIAS, biomeParams.frequency,
+        MASK_LACUNARITY, MASK_GAIN };
+    hashBytes(h, constants, sizeof(constants));
+    hashBytes(h, parameters, sizeof(parameters));
+    plains->hashParams(h);
+    ocean->hashParams(h);
+    return h;
+}
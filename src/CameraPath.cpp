@@ -0,0 +1,71 @@
+#include "../include/CameraPath.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cstdio>
+
+#define CAMERA_PATH_VERSION 1
+
+CameraPath::CameraPath(double tickHz) : hz(tickHz)
+{
+}
+
+bool CameraPath::save(const std::string& path) const
+{
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file)
+        return false;
+
+    // %.9g round-trips a float, so a saved path replays exactly
+    std::fprintf(file, "camerapath %d %.17g\n", CAMERA_PATH_VERSION, hz);
+    for (const CameraKey& k : keys)
+        std::fprintf(file, "%.9g %.9g %.9g %.9g %.9g\n", k.position.x, k.position.y, k.position.z, k.yaw, k.pitch);
+
+    bool ok = std::ferror(file) == 0;
+    return std::fclose(file) == 0 && ok;
+}
+
+bool CameraPath::load(const std::string& path)
+{
+    keys.clear();
+    FILE* file = std::fopen(path.c_str(), "r");
+    if (!file)
+        return false;
+
+    int version = 0;
+    double tickHz = 0.0;
+    bool ok = std::fscanf(file, " camerapath %d %lf", &version, &tickHz) == 2
+        && version == CAMERA_PATH_VERSION && tickHz > 0.0;
+
+    CameraKey k;
+    int fields = 0;
+    while (ok && (fields = std::fscanf(file, "%f %f %f %f %f", &k.position.x, &k.position.y, &k.position.z, &k.yaw, &k.pitch)) == 5)
+        keys.push_back(k);
+
+    // Anything but a clean end of file after the last key is a damaged file
+    ok = ok && fields == EOF && !std::ferror(file);
+    std::fclose(file);
+
+    if (!ok)
+    {
+        keys.clear();
+        return false;
+    }
+    hz = tickHz;
+    return true;
+}
+
+/* ------------------------- */
+/* Same vectors as Camera::updateCameraVectors */
+/* ------------------------- */
+glm::mat4 CameraPath::viewMatrix(const CameraKey& key)
+{
+    glm::vec3 front;
+    front.x = cos(glm::radians(key.yaw)) * cos(glm::radians(key.pitch));
+    front.y = sin(glm::radians(key.pitch));
+    front.z = sin(glm::radians(key.yaw)) * cos(glm::radians(key.pitch));
+    front = glm::normalize(front);
+
+    glm::vec3 worldUp(0.0f, 1.0f, 0.0f);
+    glm::vec3 right = glm::normalize(glm::cross(front, worldUp));
+    glm::vec3 up = glm::normalize(glm::cross(right, front));
+    return glm::lookAt(key.position, key.position + front, up);
+}
@@ -1,112 +1,289 @@
 ﻿#define GLM_ENABLE_EXPERIMENTAL
 #include "../include/Chunk.h"
 #include "../include/Voxel.h"
+#include "../include/HeightTileCache.h"
 #include <glm/gtc/noise.hpp>
 #include <glm/gtx/normal.hpp>
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 /* -------------------------- */
 /* Chunk Constructor          */
-/* Allocates density 3D array */
+/* Allocates density 3D array at the LOD's stride */
 /* -------------------------- */
-Chunk::Chunk(glm::ivec2 pos, const BiomeManager* biomeMgr)
-    : position(pos), biome(biomeMgr), mesh(nullptr), dirty(true)
+Chunk::Chunk(glm::ivec2 pos, const BiomeManager* biomeMgr, HeightTileCache* tileCache, int lodLevel)
+    : position(pos), biome(biomeMgr), tiles(tileCache),
+      level(lodLevel), cells(CHUNK_SIZE >> lodLevel), layers(CHUNK_HEIGHT >> lodLevel), step(VOXEL_SIZE << lodLevel),
+      density((CHUNK_SIZE >> lodLevel) + 1, (CHUNK_HEIGHT >> lodLevel) + 1, (CHUNK_SIZE >> lodLevel) + 1, DENSITY_AXIS_ORDER),
+      arena(nullptr), meshHandle(INVALID_MESH), meshMin(0.0f), meshMax(0.0f), regularCount(0), dirty(true)
 {
-    // Allocate 3D density field with one extra for boundary (CHUNK_SIZE+1)
-    density.resize(
-        CHUNK_SIZE + 1,
-        std::vector<std::vector<float>>(CHUNK_HEIGHT + 1,
-            std::vector<float>(CHUNK_SIZE + 1)));
+    density.cornerOffsets(cornerOffset);
+    columns.resize((cells + 3) * (cells + 3));
+    nearOceanLattice.resize((CHUNK_SIZE / NEAR_OCEAN_SPACING + 1) * (CHUNK_SIZE / NEAR_OCEAN_SPACING + 1));
+    cellBands.resize(cells * cells);
+    if (level > 0)
+        faceMidHeights.resize(FACE_COUNT * cells);
+    for (IndexRange& range : transitions)
+        range = { 0u, 0u };
 }
 
 /* -------------------------- */
 /* Chunk Destructor           */
-/* Cleans up allocated mesh  */
+/* Returns the mesh ranges to the arena  */
 /* -------------------------- */
 Chunk::~Chunk()
 {
-    if (mesh)
-        delete mesh;
+    if (arena)
+        arena->release(meshHandle);
+}
+
+/* -------------------------- */
+/* Sample biome height/oceanWeight once per (x,z) column */
+/* BiomeManager::sample only depends on (wx,wz) */
+/* Includes a one-column apron; copied from the shared tile cache */
+/* or sampled in one batched sampleGrid call */
+/* Coarser LODs sample every step-th column directly: the tiles hold */
+/* full-resolution columns they would mostly not use */
+/* -------------------------- */
+void Chunk::sampleColumns()
+{
+    if (tiles && level == 0)
+    {
+        tiles->fillColumns(position.x * CHUNK_SIZE - 1, position.y * CHUNK_SIZE - 1,
+            CHUNK_SIZE + 3, CHUNK_SIZE + 3, columns.data());
+        return;
+    }
+
+    // Column (-1,-1) in world units; the table is laid out like sampleGrid's output
+    glm::vec2 origin(position.x * CHUNK_SIZE * VOXEL_SIZE - step,
+        position.y * CHUNK_SIZE * VOXEL_SIZE - step);
+
+    biome->sampleGrid(origin, float(step), cells + 3, cells + 3, columns.data());
+
+    if (level == 0)
+        return;
+
+    // The finer neighbour also has a column halfway between each pair of
+    // border columns; the transition strips need its height there
+    std::vector<BiomeSample> mid(cells);
+    for (int face = 0; face < FACE_COUNT; ++face)
+    {
+        glm::ivec2 first = faceColumn(face, 0);
+        glm::ivec2 along = faceColumn(face, 1) - first;
+        glm::vec2 start(position.x * CHUNK_SIZE * VOXEL_SIZE + first.x * step + along.x * (step / 2),
+            position.y * CHUNK_SIZE * VOXEL_SIZE + first.y * step + along.y * (step / 2));
+
+        biome->sampleGrid(start, float(step), along.x ? cells : 1, along.y ? cells : 1, mid.data());
+        for (int i = 0; i < cells; ++i)
+            faceMidHeights[face * cells + i] = mid[i].height;
+    }
+}
+
+const BiomeSample& Chunk::columnAt(int x, int z) const
+{
+    return columns[(x + 1) * (cells + 3) + (z + 1)];
+}
+
+glm::ivec2 Chunk::faceColumn(int face, int i) const
+{
+    switch (face)
+    {
+    case FACE_NEG_X: return glm::ivec2(0, i);
+    case FACE_POS_X: return glm::ivec2(cells, i);
+    case FACE_NEG_Z: return glm::ivec2(i, 0);
+    default:         return glm::ivec2(i, cells);
+    }
+}
+
+glm::ivec2 Chunk::faceDirection(int face)
+{
+    static const glm::ivec2 directions[FACE_COUNT] = {
+        glm::ivec2(-1, 0), glm::ivec2(1, 0), glm::ivec2(0, -1), glm::ivec2(0, 1)
+    };
+    return directions[face];
+}
+
+/* -------------------------- */
+/* Density gradient at a lattice column */
+/* density = height(x,z) - y, so d/dy is constant and x/z come from */
+/* central differences of neighbouring column heights */
+/* Scaled by 2 * step; only the direction is used */
+/* -------------------------- */
+glm::vec3 Chunk::latticeGradient(int x, int z) const
+{
+    float dx = columnAt(x + 1, z).height - columnAt(x - 1, z).height;
+    float dz = columnAt(x, z + 1).height - columnAt(x, z - 1).height;
+    return glm::vec3(dx, -2.0f * step, dz);
+}
+
+/* -------------------------- */
+/* nearOcean on a world-aligned lattice every NEAR_OCEAN_SPACING voxels */
+/* Each point costs up to nine mask samples; neighbouring chunks and LODs */
+/* share the lattice points on their common edges */
+/* -------------------------- */
+void Chunk::sampleNearOcean()
+{
+    const int side = CHUNK_SIZE / NEAR_OCEAN_SPACING + 1;
+    const float spacing = float(NEAR_OCEAN_SPACING * VOXEL_SIZE);
+    glm::vec3 o = origin();
+
+    for (int x = 0; x < side; ++x)
+        for (int z = 0; z < side; ++z)
+            nearOceanLattice[x * side + z] = biome->nearOcean(o.x + x * spacing, o.z + z * spacing) ? 1 : 0;
+}
+
+/* -------------------------- */
+/* Pack a surface vertex, coloured by blending the biomes at it */
+/* Ocean weight is interpolated from the four columns around the vertex */
+/* and nearOcean taken from the nearest lattice point, so no vertex */
+/* samples noise */
+/* -------------------------- */
+PackedVertex Chunk::surfaceVertex(const glm::vec3& vLocal, const glm::vec3& normal) const
+{
+    float fx = vLocal.x / step, fz = vLocal.z / step;
+    int x = glm::clamp(int(fx), 0, cells - 1), z = glm::clamp(int(fz), 0, cells - 1);
+    float tx = fx - x, tz = fz - z;
+    float oceanW = glm::mix(
+        glm::mix(columnAt(x, z).oceanWeight, columnAt(x, z + 1).oceanWeight, tz),
+        glm::mix(columnAt(x + 1, z).oceanWeight, columnAt(x + 1, z + 1).oceanWeight, tz), tx);
+
+    const int side = CHUNK_SIZE / NEAR_OCEAN_SPACING + 1;
+    const float spacing = float(NEAR_OCEAN_SPACING * VOXEL_SIZE);
+    int nx = glm::clamp(int(vLocal.x / spacing + 0.5f), 0, side - 1);
+    int nz = glm::clamp(int(vLocal.z / spacing + 0.5f), 0, side - 1);
+
+    return packVertex(vLocal, normal, biome->surfaceColor(vLocal.y, oceanW, nearOceanLattice[nx * side + nz] != 0));
+}
+
+/* -------------------------- */
+/* Surface crossing on a horizontal lattice edge from p0 (density d0) */
+/* to p1. Regular cells and transition strips both place their vertices */
+/* with this, so the two sides of an LOD seam agree bit for bit. Kept */
+/* out of line: inlined, each caller could contract the mix into FMA */
+/* its own way and round the crossing differently */
+/* -------------------------- */
+#if defined(_MSC_VER)
+#define CHUNK_NOINLINE __declspec(noinline)
+#else
+#define CHUNK_NOINLINE __attribute__((noinline))
+#endif
+
+CHUNK_NOINLINE static glm::vec3 crossEdge(const glm::vec3& p0, const glm::vec3& p1, float d0, float d1, float isoLevel, float& t)
+{
+    t = (isoLevel - d0) / (d1 - d0);
+    t = glm::clamp(t, 0.0f, 1.0f);
+    return glm::mix(p0, p1, t);
 }
 
 /* -------------------------- */
 /* Generate density field for entire chunk */
 /* Density = surfaceHeight - current voxel world y */
 /* Positive density = inside terrain, negative = outside */
+/* Fills the apron too, so lookups never fall back to noise */
 /* -------------------------- */
 void Chunk::generateDensityField()
 {
-    int worldX = position.x * CHUNK_SIZE;
-    int worldZ = position.y * CHUNK_SIZE;
+    sampleColumns();
+    sampleNearOcean();
 
-    for (int x = 0; x <= CHUNK_SIZE; ++x)
-        for (int y = 0; y <= CHUNK_HEIGHT; ++y)
-            for (int z = 0; z <= CHUNK_SIZE; ++z)
-            {
-                float wx = (x + worldX) * VOXEL_SIZE;
-                float wz = (z + worldZ) * VOXEL_SIZE;
-                float wy = y * VOXEL_SIZE;
+    for (int x = -1; x <= cells + 1; ++x)
+        for (int y = -1; y <= layers + 1; ++y)
+        {
+            float wy = y * step;
 
-                float surfaceY = biome->sample(wx, wz).height;
-                density[x][y][z] = surfaceY - wy;
-            }
+            for (int z = -1; z <= cells + 1; ++z)
+                density.at(x, y, z) = columnAt(x, z).height - wy;
+        }
 
+    computeCellBands();
     dirty = true;
 }
 
+/* -------------------------- */
+/* Height band of each cell column */
+/* density = height - y, so a cell can only straddle the surface */
+/* if its y range overlaps [min, max] of its four corner heights */
+/* -------------------------- */
+void Chunk::computeCellBands()
+{
+    for (int x = 0; x < cells; ++x)
+        for (int z = 0; z < cells; ++z)
+        {
+            float h00 = columnAt(x, z).height;
+            float h10 = columnAt(x + 1, z).height;
+            float h01 = columnAt(x, z + 1).height;
+            float h11 = columnAt(x + 1, z + 1).height;
+
+            float hMin = std::min(std::min(h00, h10), std::min(h01, h11));
+            float hMax = std::max(std::max(h00, h10), std::max(h01, h11));
+
+            // Cell y spans [y, y + 1] * step; widen by one cell
+            // so corners sitting exactly on the surface are kept
+            int yMin = int(std::floor(hMin / step)) - 1;
+            int yMax = int(std::floor(hMax / step)) + 1;
+
+            CellBand& band = cellBands[x * cells + z];
+            band.yMin = std::max(yMin, 0);
+            band.yMax = std::min(yMax, layers - 1);
+        }
+}
+
 /* -------------------------- */
 /* Get density value at voxel coordinate (x,y,z) */
-/* Returns cached density if in bounds, otherwise computes on the fly */
+/* Always served from the padded density field */
+/* -------------------------- */
+float Chunk::getDensityAt(int x, int y, int z) const
+{
+    return density.at(x, y, z);
+}
+
+/* -------------------------- */
+/* Edge cache for shared-vertex meshing */
+/* Two planes of y/z-edges plus the x-edges between them */
 /* -------------------------- */
-float Chunk::getDensityAt(int x, int y, int z)
+Chunk::EdgeCache::EdgeCache(int cellsY, int cellsZ)
+    : rowLength(cellsZ + 1),
+      xEdges((cellsY + 1) * (cellsZ + 1), -1),
+      lo((cellsY + 1) * (cellsZ + 1) * 2, -1),
+      hi((cellsY + 1) * (cellsZ + 1) * 2, -1)
 {
-    if (x >= 0 && x <= CHUNK_SIZE &&
-        y >= 0 && y <= CHUNK_HEIGHT &&
-        z >= 0 && z <= CHUNK_SIZE)
-        return density[x][y][z];
+}
 
-    float wx = (x + position.x * CHUNK_SIZE) * VOXEL_SIZE;
-    float wz = (z + position.y * CHUNK_SIZE) * VOXEL_SIZE;
-    float wy = y * VOXEL_SIZE;
+void Chunk::EdgeCache::advance()
+{
+    std::swap(lo, hi);
+    std::fill(hi.begin(), hi.end(), -1);
+    std::fill(xEdges.begin(), xEdges.end(), -1);
+}
 
-    return biome->sample(wx, wz).height - wy;
+int& Chunk::EdgeCache::at(int dx, int y, int z, int axis)
+{
+    int cell = y * rowLength + z;
+    if (axis == 0)
+        return xEdges[cell];
+
+    return (dx ? hi : lo)[cell * 2 + axis - 1];
 }
 
 /* -------------------------- */
 /* Polygonise a single cube in the density field using marching cubes */
-/* Generates vertices, colors, normals, and indices */
+/* Generates packed vertices (position, normal, colour) and indices */
+/* Each crossed lattice edge gets one vertex shared by all adjacent cubes */
 /* -------------------------- */
 void Chunk::polygoniseCube(int x, int y, int z,
-    std::vector<glm::vec3>& vertices,
-    std::vector<glm::vec3>& colors,
-    std::vector<glm::vec3>& normals,
+    std::vector<PackedVertex>& vertices,
     std::vector<unsigned int>& indices,
-    int& indexOffset,
+    EdgeCache& edgeCache,
     float isoLevel)
 {
-    // Colour helper that blends biomes
-    auto vertexColour = [&](const glm::vec3& vLocal) -> glm::vec3
-    {
-        float wx = vLocal.x + position.x * CHUNK_SIZE * VOXEL_SIZE;
-        float wz = vLocal.z + position.y * CHUNK_SIZE * VOXEL_SIZE;
-        float wy = vLocal.y;
-        auto sample = biome->sample(wx, wz);
-        return biome->blendedSurfaceColor(wy, sample.oceanWeight, wx, wz);
-    };
-
     // Get densities at cube corners
+    const float* cube = density.ptr(x, y, z);
     float d[8];
-    d[0] = getDensityAt(x, y, z);
-    d[1] = getDensityAt(x + 1, y, z);
-    d[2] = getDensityAt(x + 1, y, z + 1);
-    d[3] = getDensityAt(x, y, z + 1);
-    d[4] = getDensityAt(x, y + 1, z);
-    d[5] = getDensityAt(x + 1, y + 1, z);
-    d[6] = getDensityAt(x + 1, y + 1, z + 1);
-    d[7] = getDensityAt(x, y + 1, z + 1);
+    for (int i = 0; i < 8; ++i)
+        d[i] = cube[cornerOffset[i]];
 
     // Quick rejection if all corners inside or outside the surface
     bool allInside = true, allOutside = true;
@@ -127,154 +304,356 @@ void Chunk::polygoniseCube(int x, int y, int z,
     if (edgeTable[cubeIndex] == 0)
         return;
 
-    // Interpolate vertices along edges where the surface crosses
-    glm::vec3 vertList[12];
+    // Look up (or emit) the shared vertex on every edge the surface crosses
+    int vertList[12];
     for (int i = 0; i < 12; ++i)
     {
-        if (edgeTable[cubeIndex] & (1 << i))
+        if (!(edgeTable[cubeIndex] & (1 << i)))
+            continue;
+
+        const int* e = edgeLattice[i];
+        int& id = edgeCache.at(e[0], y + e[1], z + e[2], e[3]);
+        if (id < 0)
         {
+            // Interpolate from the lower lattice corner so the vertex
+            // does not depend on which neighbouring cube emits it
             int v0 = edgeVertexIndices[i][0];
             int v1 = edgeVertexIndices[i][1];
-            float t = (isoLevel - d[v0]) / (d[v1] - d[v0]);
-            t = glm::clamp(t, 0.0f, 1.0f);
+            if (vertexOffsets[v0][e[3]] > vertexOffsets[v1][e[3]])
+                std::swap(v0, v1);
+
+            glm::vec3 p0 = (vertexOffsets[v0] + glm::vec3(x, y, z)) * float(step);
+            glm::vec3 p1 = (vertexOffsets[v1] + glm::vec3(x, y, z)) * float(step);
+
+            float t;
+            glm::vec3 v;
+            if (e[3] == 1)
+            {
+                // density = height - y, so a y-edge is crossed exactly at the
+                // column height; every LOD puts this vertex at the same place
+                v = p0;
+                v.y = glm::clamp(columnAt(x + int(vertexOffsets[v0].x), z + int(vertexOffsets[v0].z)).height, p0.y, p1.y);
+                t = (v.y - p0.y) / (p1.y - p0.y);
+            }
+            else
+            {
+                v = crossEdge(p0, p1, d[v0], d[v1], isoLevel, t);
+            }
 
-            glm::vec3 p0 = (vertexOffsets[v0] + glm::vec3(x, y, z)) * float(VOXEL_SIZE);
-            glm::vec3 p1 = (vertexOffsets[v1] + glm::vec3(x, y, z)) * float(VOXEL_SIZE);
-            vertList[i] = glm::mix(p0, p1, t);
+            // Calculate normal from the grid gradients at both edge corners
+            glm::vec3 g0 = latticeGradient(x + int(vertexOffsets[v0].x), z + int(vertexOffsets[v0].z));
+            glm::vec3 g1 = latticeGradient(x + int(vertexOffsets[v1].x), z + int(vertexOffsets[v1].z));
+            glm::vec3 n = -glm::normalize(glm::mix(g0, g1, t));
+
+            id = (int)vertices.size();
+            vertices.push_back(surfaceVertex(v, n));  // Colour based on vertex height
         }
+        vertList[i] = id;
     }
 
     // Generate triangles from triTable for this cubeIndex
     for (int i = 0; triTable[cubeIndex][i] != -1; i += 3)
     {
-        glm::vec3 v0 = vertList[triTable[cubeIndex][i]];
-        glm::vec3 v1 = vertList[triTable[cubeIndex][i + 1]];
-        glm::vec3 v2 = vertList[triTable[cubeIndex][i + 2]];
+        // Add triangle indices (note winding order)
+        indices.push_back(vertList[triTable[cubeIndex][i]]);
+        indices.push_back(vertList[triTable[cubeIndex][i + 2]]);
+        indices.push_back(vertList[triTable[cubeIndex][i + 1]]);
+    }
+}
+
+/* -------------------------- */
+/* Transition strip for one face (Transvoxel-style, zero width) */
+/* A neighbour one LOD finer meshes this face's plane at half the step, */
+/* so its border polyline has an extra column between each pair of ours */
+/* and crossings at twice as many levels. density = height - y has no */
+/* ambiguous cases, so both borders are the height graph through their */
+/* columns, plus collinear crossings. Per segment the gap between them is */
+/* one triangle (our two columns and the finer mid column), zipped so its */
+/* edges match every vertex of both borders: no T-junctions, no cracks */
+/* FP model: the strip has no tolerance, it relies on computing every */
+/* shared vertex exactly as the neighbour does. Column heights come from */
+/* sampleGrid, whose result for a world point does not depend on the */
+/* grid's origin, stride or the point's SIMD lane; crossings all go */
+/* through crossEdge; every lattice coordinate is an exact integer. That */
+/* holds with or without FMA contraction, but only between chunks built */
+/* by the same binary at the same SIMD level (see noiseArithmetic) */
+/* -------------------------- */
+void Chunk::buildTransition(int face,
+    std::vector<PackedVertex>& vertices,
+    std::vector<unsigned int>& indices)
+{
+    const float isoLevel = 0.0f;
+    const int half = step / 2;
+    const float top = float(layers * step);
+
+    glm::ivec2 first = faceColumn(face, 0);
+    glm::ivec2 along = faceColumn(face, 1) - first;
+    glm::ivec2 outward2 = faceDirection(face);
+    glm::vec3 alongDir(float(along.x), 0.0f, float(along.y));
+    glm::vec3 outward(float(outward2.x), 0.0f, float(outward2.y));
+
+    // Border point at distance a (world units) along the face, height y
+    auto facePoint = [&](int a, float y)
+    {
+        return glm::vec3(float(first.x * step + along.x * a), y, float(first.y * step + along.y * a));
+    };
 
-        vertices.push_back(v0);
-        vertices.push_back(v1);
-        vertices.push_back(v2);
+    // Normal at distance a along the face, blended between our columns
+    auto faceNormal = [&](float a)
+    {
+        int i = std::min(int(a) / step, cells - 1);
+        float f = (a - float(i * step)) / float(step);
+        glm::ivec2 c0 = faceColumn(face, i), c1 = faceColumn(face, i + 1);
+        return -glm::normalize(glm::mix(latticeGradient(c0.x, c0.y), latticeGradient(c1.x, c1.y), f));
+    };
 
-        // Assign colors based on vertex height
-        colors.push_back(vertexColour(v0));
-        colors.push_back(vertexColour(v1));
-        colors.push_back(vertexColour(v2));
+    // Border vertices carry their distance along the face for the zip below
+    struct BorderVertex
+    {
+        unsigned index;
+        float along;
+    };
 
-        // Calculate normals by sampling density gradient
-        const float eps = 0.25f * VOXEL_SIZE;
+    auto emit = [&](const glm::vec3& v)
+    {
+        float a = glm::dot(v - facePoint(0, v.y), alongDir);
+        vertices.push_back(surfaceVertex(v, faceNormal(a)));
+        return BorderVertex{ unsigned(vertices.size() - 1), a };
+    };
 
-        auto densitySample = [&](const glm::vec3& p) -> float
+    // Crossings of the horizontal edges from a0 to a1 at levels j * levelStep,
+    // in the order the border meets them walking from a0 to a1
+    auto appendRun = [&](int a0, int a1, float h0, float h1, int levelStep, int levelCount,
+        std::vector<BorderVertex>& chain)
+    {
+        bool rising = h1 > h0;
+        for (int k = 0; k <= levelCount; ++k)
         {
-            float wx = p.x + position.x * CHUNK_SIZE * VOXEL_SIZE;
-            float wz = p.z + position.y * CHUNK_SIZE * VOXEL_SIZE;
-            float wy = p.y;
-            return biome->sample(wx, wz).height - wy;
-        };
+            int j = rising ? k : levelCount - k;
+            float wy = float(j * levelStep);
+            float d0 = h0 - wy, d1 = h1 - wy;
+            if ((d0 < isoLevel) == (d1 < isoLevel))
+                continue;
+
+            float t;
+            chain.push_back(emit(crossEdge(facePoint(a0, wy), facePoint(a1, wy), d0, d1, isoLevel, t)));
+        }
+    };
+
+    // The y-edge vertex of a column, as polygoniseCube places it
+    auto hasColumnVertex = [&](float h) { return h >= 0.0f && h < top; };
+
+    // Triangles are built in the order of the gap's boundary, which faces
+    // away from the finer neighbour when its border is the higher one.
+    // Triangles that collapse onto a shared vertex are dropped
+    bool flip = glm::dot(glm::cross(glm::vec3(0.0f, 1.0f, 0.0f), alongDir), outward) > 0.0f;
+    auto triangle = [&](unsigned a, unsigned b, unsigned c)
+    {
+        if (a == b || b == c || c == a)
+            return;
+        indices.push_back(a);
+        indices.push_back(flip ? c : b);
+        indices.push_back(flip ? b : c);
+    };
+
+    std::vector<BorderVertex> fine, coarse;
+    BorderVertex columnVertex = {};
+    bool haveColumnVertex = false;
+
+    for (int i = 0; i < cells; ++i)
+    {
+        glm::ivec2 c0 = faceColumn(face, i), c1 = faceColumn(face, i + 1);
+        float h0 = columnAt(c0.x, c0.y).height;
+        float h1 = columnAt(c1.x, c1.y).height;
+        float hm = faceMidHeights[face * cells + i];
+        int a0 = i * step, am = a0 + half, a1 = a0 + step;
 
-        auto gradient = [&](const glm::vec3& p) -> glm::vec3
+        if (!hasColumnVertex(h0) || !hasColumnVertex(hm) || !hasColumnVertex(h1))
         {
-            float dx = densitySample(glm::vec3(p.x + eps, p.y, p.z)) -
-                densitySample(glm::vec3(p.x - eps, p.y, p.z));
-            float dy = densitySample(glm::vec3(p.x, p.y + eps, p.z)) -
-                densitySample(glm::vec3(p.x, p.y - eps, p.z));
-            float dz = densitySample(glm::vec3(p.x, p.y, p.z + eps)) -
-                densitySample(glm::vec3(p.x, p.y, p.z - eps));
-            return glm::vec3(dx, dy, dz);
-        };
-
-        glm::vec3 n0 = -glm::normalize(gradient(v0));
-        glm::vec3 n1 = -glm::normalize(gradient(v1));
-        glm::vec3 n2 = -glm::normalize(gradient(v2));
-
-        // Fallback normals if too small
-        if (glm::length(n0) < 1e-3f) n0 = glm::vec3(0, 1, 0);
-        if (glm::length(n1) < 1e-3f) n1 = glm::vec3(0, 1, 0);
-        if (glm::length(n2) < 1e-3f) n2 = glm::vec3(0, 1, 0);
-
-        normals.push_back(n0);
-        normals.push_back(n1);
-        normals.push_back(n2);
+            haveColumnVertex = false;  // Border leaves the chunk: no seam here
+            continue;
+        }
 
-        // Add triangle indices (note winding order)
-        indices.push_back(indexOffset);
-        indices.push_back(indexOffset + 2);
-        indices.push_back(indexOffset + 1);
-        indexOffset += 3;
+        // Column vertices are shared with the next segment
+        BorderVertex start = haveColumnVertex ? columnVertex : emit(facePoint(a0, h0));
+        BorderVertex end = emit(facePoint(a1, h1));
+        columnVertex = end;
+        haveColumnVertex = true;
+
+        fine.assign(1, start);
+        appendRun(a0, am, h0, hm, half, layers * 2, fine);
+        fine.push_back(emit(facePoint(am, hm)));
+        appendRun(am, a1, hm, h1, half, layers * 2, fine);
+        fine.push_back(end);
+
+        coarse.assign(1, start);
+        appendRun(a0, a1, h0, h1, step, layers, coarse);
+        coarse.push_back(end);
+
+        // Near our columns the borders converge, and a crossing of ours can
+        // quantize onto one of the finer border's. Share that vertex so the
+        // gap splits there instead of folding over itself
+        for (std::size_t c = 1; c + 1 < coarse.size(); ++c)
+            for (std::size_t f = 1; f + 1 < fine.size(); ++f)
+                if (std::memcmp(vertices[coarse[c].index].position, vertices[fine[f].index].position,
+                    sizeof(PackedVertex::position)) == 0)
+                {
+                    coarse[c] = fine[f];
+                    break;
+                }
+
+        // Zip the two borders together in order along the face; both are
+        // monotone in that direction, so the triangles never overlap
+        std::size_t f = 0, c = 0;
+        while (f + 1 < fine.size() || c + 1 < coarse.size())
+        {
+            bool advanceFine = c + 1 == coarse.size() ||
+                (f + 1 < fine.size() && fine[f + 1].along <= coarse[c + 1].along);
+            if (advanceFine)
+            {
+                triangle(fine[f].index, fine[f + 1].index, coarse[c].index);
+                ++f;
+            }
+            else
+            {
+                triangle(fine[f].index, coarse[c + 1].index, coarse[c].index);
+                ++c;
+            }
+        }
     }
 }
 
 /* -------------------------- */
 /* Build entire mesh data for chunk by polygonizing all cubes */
-/* Offsets vertices to world position */
+/* Vertices stay chunk-local; the shader adds origin() */
 /* -------------------------- */
-void Chunk::buildMeshData(std::vector<glm::vec3>& vertices,
-    std::vector<glm::vec3>& colors,
-    std::vector<glm::vec3>& normals,
+void Chunk::buildMeshData(std::vector<PackedVertex>& vertices,
     std::vector<unsigned int>& indices)
 {
     if (!dirty)
         return; // No rebuild needed
 
     vertices.clear();
-    colors.clear();
-    normals.clear();
     indices.clear();
 
-    int indexOffset = 0;
+    EdgeCache edgeCache(layers, cells);
     float isoLevel = 0.0f; // Surface threshold
 
-    for (int x = 0; x < CHUNK_SIZE; ++x)
-        for (int y = 0; y < CHUNK_HEIGHT; ++y)
-            for (int z = 0; z < CHUNK_SIZE; ++z)
-                polygoniseCube(x, y, z, vertices, colors, normals, indices, indexOffset, isoLevel);
+    // Only visit the cells in each column's height band; everything
+    // above or below is entirely outside or inside the terrain
+    for (int x = 0; x < cells; ++x)
+    {
+        for (int z = 0; z < cells; ++z)
+        {
+            const CellBand& band = cellBands[x * cells + z];
+            for (int y = band.yMin; y <= band.yMax; ++y)
+                polygoniseCube(x, y, z, vertices, indices, edgeCache, isoLevel);
+        }
+
+        edgeCache.advance();
+    }
+    regularCount = unsigned(indices.size());
 
-    // Offset all vertices by chunk world position
-    glm::vec3 offset(position.x * CHUNK_SIZE * VOXEL_SIZE,
-        0.0f,
-        position.y * CHUNK_SIZE * VOXEL_SIZE);
+    // Transition strips follow the regular cells, one index range per face
+    for (int face = 0; face < FACE_COUNT; ++face)
+    {
+        unsigned first = unsigned(indices.size());
+        if (level > 0)
+            buildTransition(face, vertices, indices);
+        transitions[face] = { first, unsigned(indices.size()) - first };
+    }
 
-    for (auto& v : vertices)
-        v += offset;
+    // Tight bounds for culling: terrain usually fills a thin band of the chunk height
+    std::uint16_t lo[3] = { 0xFFFF, 0xFFFF, 0xFFFF }, hi[3] = { 0, 0, 0 };
+    for (const PackedVertex& v : vertices)
+    {
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            lo[axis] = std::min(lo[axis], v.position[axis]);
+            hi[axis] = std::max(hi[axis], v.position[axis]);
+        }
+    }
+    const float scale = 1.0f / POSITION_STEPS_PER_UNIT;
+    meshMin = glm::vec3(lo[0], lo[1], lo[2]) * scale;
+    meshMax = glm::vec3(hi[0], hi[1], hi[2]) * scale;
 
     dirty = false;
 }
 
 /* -------------------------- */
-/* Generates chunk mesh data (vertices, colors, normals, indices) */
+/* Generates chunk mesh data (packed vertices, indices) */
 /* Returns true if mesh contains any vertices */
 /* -------------------------- */
-bool Chunk::generateData(std::vector<glm::vec3>& vertices,
-    std::vector<glm::vec3>& colors,
-    std::vector<glm::vec3>& normals,
+bool Chunk::generateData(std::vector<PackedVertex>& vertices,
     std::vector<unsigned int>& indices)
 {
     if (dirty)
         generateDensityField();
 
-    buildMeshData(vertices, colors, normals, indices);
+    buildMeshData(vertices, indices);
     return !vertices.empty();
 }
 
 /* -------------------------- */
-/* Finalizes mesh by uploading to GPU buffers */
-/* Deletes existing mesh if any */
+/* Finalizes mesh by uploading into the mesh arena */
+/* Releases the existing ranges if any */
 /* -------------------------- */
-void Chunk::finalize(std::vector<glm::vec3>& vertices,
-    std::vector<glm::vec3>& colors,
-    std::vector<glm::vec3>& normals,
-    std::vector<unsigned int>& indices)
+void Chunk::finalize(MeshArena* meshArena,
+    const std::vector<PackedVertex>& vertices,
+    const std::vector<unsigned int>& indices)
+{
+    finalize(meshArena, vertices.data(), vertices.size(), indices.data(), indices.size());
+}
+
+void Chunk::finalize(MeshArena* meshArena,
+    const PackedVertex* vertices, std::size_t vertexCount,
+    const unsigned int* indices, std::size_t indexCount)
+{
+    if (arena)
+        arena->release(meshHandle);
+
+    arena = meshArena;
+    meshHandle = arena->allocate(vertices, vertexCount, indices, indexCount, origin());
+}
+
+Chunk::MeshInfo Chunk::meshInfo() const
 {
-    if (mesh)
-        delete mesh;
+    MeshInfo info;
+    info.regularCount = regularCount;
+    for (int face = 0; face < FACE_COUNT; ++face)
+        info.transitions[face] = transitions[face];
+    info.meshMin = meshMin;
+    info.meshMax = meshMax;
+    return info;
+}
+
+void Chunk::restoreMesh(const MeshInfo& info)
+{
+    regularCount = info.regularCount;
+    for (int face = 0; face < FACE_COUNT; ++face)
+        transitions[face] = info.transitions[face];
+    meshMin = info.meshMin;
+    meshMax = info.meshMax;
+    dirty = false;
+}
 
-    mesh = vertices.empty() ? nullptr : new Mesh(vertices, colors, normals, indices);
+glm::vec3 Chunk::origin() const
+{
+    return glm::vec3(position.x * CHUNK_SIZE * VOXEL_SIZE, 0.0f, position.y * CHUNK_SIZE * VOXEL_SIZE);
+}
+
+void Chunk::bounds(glm::vec3& minCorner, glm::vec3& maxCorner) const
+{
+    minCorner = origin() + meshMin;
+    maxCorner = origin() + meshMax;
 }
 
 /* -------------------------- */
-/* Draw the chunk's mesh */
+/* Draw the chunk's mesh on its own */
+/* The arena's page table supplies the chunk origin to the shader */
 /* -------------------------- */
 void Chunk::draw(const Shader& shader)
 {
-    if (mesh)
-        mesh->draw();
+    if (meshHandle != INVALID_MESH)
+        arena->draw(meshHandle);
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "../include/ChunkGrid.h"
+#include <algorithm>
+#include <cstdlib>
+
+ChunkGrid::ChunkGrid(int minSize)
+    : side(1)
+{
+    // A power-of-two side turns the wrap into a mask
+    while (side < minSize)
+        side <<= 1;
+    shift = 0;
+    while ((1 << shift) < side)
+        shift++;
+    slots.assign(std::size_t(side) * side, Entry{ glm::ivec2(0), nullptr });
+}
+
+std::size_t ChunkGrid::slotIndex(glm::ivec2 pos) const
+{
+    // Two's complement masking wraps negative coordinates too
+    unsigned mask = unsigned(side - 1);
+    return (std::size_t(unsigned(pos.x) & mask) << shift) | (unsigned(pos.y) & mask);
+}
+
+Chunk* ChunkGrid::find(glm::ivec2 pos) const
+{
+    const Entry& e = slots[slotIndex(pos)];
+    return e.chunk && e.pos == pos ? e.chunk : nullptr;
+}
+
+Chunk* ChunkGrid::insert(glm::ivec2 pos, Chunk* chunk)
+{
+    Entry& e = slots[slotIndex(pos)];
+    if (!e.chunk)
+        count++;
+
+    // A stale chunk from another window position, or an older chunk at pos
+    Chunk* displaced = e.chunk != chunk ? e.chunk : nullptr;
+    e.pos = pos;
+    e.chunk = chunk;
+    return displaced;
+}
+
+Chunk* ChunkGrid::erase(glm::ivec2 pos)
+{
+    Entry& e = slots[slotIndex(pos)];
+    if (!e.chunk || e.pos != pos)
+        return nullptr;
+
+    Chunk* chunk = e.chunk;
+    e.chunk = nullptr;
+    count--;
+    return chunk;
+}
+
+void ChunkGrid::clear()
+{
+    for (Entry& e : slots)
+        e.chunk = nullptr;
+    count = 0;
+}
+
+/* -------------------------- */
+/* Window difference: whole columns where x is outside the other window, */
+/* and at most two z runs per column where it is not. Cost is the size */
+/* of the result plus one step per column */
+/* -------------------------- */
+void ChunkGrid::windowDifference(glm::ivec2 center, glm::ivec2 other, int radius, std::vector<glm::ivec2>& out)
+{
+    int zMin = center.y - radius, zMax = center.y + radius;
+    int otherMin = other.y - radius, otherMax = other.y + radius;
+
+    for (int x = center.x - radius; x <= center.x + radius; ++x)
+    {
+        if (std::abs(x - other.x) > radius)
+        {
+            for (int z = zMin; z <= zMax; ++z)
+                out.push_back(glm::ivec2(x, z));
+            continue;
+        }
+
+        for (int z = zMin; z <= std::min(zMax, otherMin - 1); ++z)
+            out.push_back(glm::ivec2(x, z));
+        for (int z = std::max(zMin, otherMax + 1); z <= zMax; ++z)
+            out.push_back(glm::ivec2(x, z));
+    }
+}
+
+void ChunkGrid::ring(glm::ivec2 center, int r, std::vector<glm::ivec2>& out)
+{
+    if (r == 0)
+    {
+        out.push_back(center);
+        return;
+    }
+
+    // Full top and bottom rows, then the two sides between them
+    for (int x = -r; x <= r; ++x)
+    {
+        out.push_back(center + glm::ivec2(x, -r));
+        out.push_back(center + glm::ivec2(x, r));
+    }
+    for (int z = -r + 1; z <= r - 1; ++z)
+    {
+        out.push_back(center + glm::ivec2(-r, z));
+        out.push_back(center + glm::ivec2(r, z));
+    }
+}
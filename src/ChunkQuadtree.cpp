@@ -0,0 +1,301 @@
+#include "../include/ChunkQuadtree.h"
+#include <algorithm>
+#include <limits>
+
+ChunkQuadtree::ChunkQuadtree(float chunkWorldSize)
+    : chunkSize(chunkWorldSize)
+{
+}
+
+/* -------------------------- */
+/* Cell arithmetic */
+/* -------------------------- */
+glm::ivec2 ChunkQuadtree::tileOf(glm::ivec2 pos)
+{
+    // Floor division, so negative coordinates get their own tiles
+    auto floorDiv = [](int v) { return (v >= 0 ? v : v - (TILE_CHUNKS - 1)) / TILE_CHUNKS; };
+    return glm::ivec2(floorDiv(pos.x), floorDiv(pos.y));
+}
+
+int ChunkQuadtree::quadrant(glm::ivec2 pos, const Cell& cell)
+{
+    int half = 1 << (cell.level - 1);
+    return int(pos.x - cell.origin.x >= half) | (int(pos.y - cell.origin.y >= half) << 1);
+}
+
+ChunkQuadtree::Cell ChunkQuadtree::child(const Cell& cell, int quadrant)
+{
+    int half = 1 << (cell.level - 1);
+    return { cell.origin + glm::ivec2((quadrant & 1) * half, (quadrant >> 1) * half), cell.level - 1 };
+}
+
+std::uint32_t ChunkQuadtree::allocateNode()
+{
+    std::uint32_t node;
+    if (!freeNodes.empty())
+    {
+        node = freeNodes.back();
+        freeNodes.pop_back();
+    }
+    else
+    {
+        node = std::uint32_t(nodes.size());
+        nodes.push_back({});
+    }
+
+    Node& n = nodes[node];
+    std::fill(std::begin(n.children), std::end(n.children), NO_NODE);
+    n.minY = std::numeric_limits<float>::max();
+    n.maxY = std::numeric_limits<float>::lowest();
+    n.chunks = 0;
+    n.id = 0;
+    return node;
+}
+
+void ChunkQuadtree::freeNode(std::uint32_t node)
+{
+    freeNodes.push_back(node);
+}
+
+void ChunkQuadtree::refit(std::uint32_t node)
+{
+    Node& n = nodes[node];
+    n.minY = std::numeric_limits<float>::max();
+    n.maxY = std::numeric_limits<float>::lowest();
+    n.chunks = 0;
+    for (std::uint32_t c : n.children)
+    {
+        if (c == NO_NODE)
+            continue;
+        n.minY = std::min(n.minY, nodes[c].minY);
+        n.maxY = std::max(n.maxY, nodes[c].maxY);
+        n.chunks += nodes[c].chunks;
+    }
+}
+
+/* -------------------------- */
+/* Insert: create the missing path, set the leaf, refit upwards */
+/* -------------------------- */
+void ChunkQuadtree::insert(glm::ivec2 pos, std::uint32_t id, float minY, float maxY)
+{
+    glm::ivec2 tile = tileOf(pos);
+    auto it = tiles.find(tile);
+    if (it == tiles.end())
+        it = tiles.emplace(tile, allocateNode()).first;
+
+    std::uint32_t path[TILE_LEVELS + 1];
+    Cell cell = { tile * TILE_CHUNKS, TILE_LEVELS };
+    path[TILE_LEVELS] = it->second;
+
+    for (int level = TILE_LEVELS; level > 0; --level)
+    {
+        int q = quadrant(pos, cell);
+        std::uint32_t next = nodes[path[level]].children[q];
+        if (next == NO_NODE)
+        {
+            next = allocateNode();   // May reallocate nodes: index again below
+            nodes[path[level]].children[q] = next;
+        }
+        path[level - 1] = next;
+        cell = child(cell, q);
+    }
+
+    Node& leaf = nodes[path[0]];
+    if (leaf.chunks == 0)
+        count++;
+    leaf.id = id;
+    leaf.minY = minY;
+    leaf.maxY = maxY;
+    leaf.chunks = 1;
+
+    for (int level = 1; level <= TILE_LEVELS; ++level)
+        refit(path[level]);
+}
+
+/* -------------------------- */
+/* Remove: drop the leaf, then refit or free each node on the way up */
+/* -------------------------- */
+void ChunkQuadtree::remove(glm::ivec2 pos)
+{
+    glm::ivec2 tile = tileOf(pos);
+    auto it = tiles.find(tile);
+    if (it == tiles.end())
+        return;
+
+    std::uint32_t path[TILE_LEVELS + 1];
+    int quadrants[TILE_LEVELS + 1];
+    Cell cell = { tile * TILE_CHUNKS, TILE_LEVELS };
+    path[TILE_LEVELS] = it->second;
+
+    for (int level = TILE_LEVELS; level > 0; --level)
+    {
+        int q = quadrant(pos, cell);
+        std::uint32_t next = nodes[path[level]].children[q];
+        if (next == NO_NODE)
+            return;
+        quadrants[level] = q;
+        path[level - 1] = next;
+        cell = child(cell, q);
+    }
+
+    freeNode(path[0]);
+    count--;
+
+    bool unlink = true;   // The node below was freed
+    for (int level = 1; level <= TILE_LEVELS; ++level)
+    {
+        Node& n = nodes[path[level]];
+        if (unlink)
+            n.children[quadrants[level]] = NO_NODE;
+        refit(path[level]);
+
+        unlink = n.chunks == 0;
+        if (unlink)
+            freeNode(path[level]);
+    }
+
+    if (unlink)
+        tiles.erase(it);
+}
+
+void ChunkQuadtree::clear()
+{
+    tiles.clear();
+    nodes.clear();
+    freeNodes.clear();
+    count = 0;
+}
+
+bool ChunkQuadtree::contains(glm::ivec2 pos) const
+{
+    glm::ivec2 tile = tileOf(pos);
+    auto it = tiles.find(tile);
+    if (it == tiles.end())
+        return false;
+
+    std::uint32_t node = it->second;
+    Cell cell = { tile * TILE_CHUNKS, TILE_LEVELS };
+    while (cell.level > 0)
+    {
+        int q = quadrant(pos, cell);
+        node = nodes[node].children[q];
+        if (node == NO_NODE)
+            return false;
+        cell = child(cell, q);
+    }
+    return true;
+}
+
+/* -------------------------- */
+/* Hierarchical frustum culling */
+/* Subtrees entirely outside are skipped, subtrees entirely inside */
+/* are taken without further tests */
+/* -------------------------- */
+void ChunkQuadtree::cull(const Frustum& frustum, std::vector<std::uint32_t>& visible) const
+{
+    visible.clear();
+    for (const auto& tile : tiles)
+        cullNode(tile.second, { tile.first * TILE_CHUNKS, TILE_LEVELS }, frustum, ALL_PLANES, visible);
+}
+
+// planes has a bit per frustum plane the parent straddles; the others
+// have the whole parent (and so this node) on their inner side
+void ChunkQuadtree::cullNode(std::uint32_t node, const Cell& cell, const Frustum& frustum, unsigned planes,
+    std::vector<std::uint32_t>& visible) const
+{
+    const Node& n = nodes[node];
+    float side = float(1 << cell.level) * chunkSize;
+    glm::vec3 extents(side * 0.5f, (n.maxY - n.minY) * 0.5f, side * 0.5f);
+    glm::vec3 center(cell.origin.x * chunkSize + extents.x, n.minY + extents.y, cell.origin.y * chunkSize + extents.z);
+
+    for (int i = 0; i < 6; ++i)
+    {
+        if (!(planes & (1u << i)))
+            continue;
+
+        float s = glm::dot(glm::vec3(frustum.planes[i]), center) + frustum.planes[i].w;
+        float r = glm::dot(frustum.absNormals[i], extents);
+        if (s + r < 0.0f)
+            return;
+        if (s - r >= 0.0f)
+            planes &= ~(1u << i);
+    }
+
+    if (planes == 0 || cell.level == 0)
+    {
+        collectIds(node, cell.level, visible);
+        return;
+    }
+
+    for (int q = 0; q < 4; ++q)
+        if (n.children[q] != NO_NODE)
+            cullNode(n.children[q], child(cell, q), frustum, planes, visible);
+}
+
+void ChunkQuadtree::collectIds(std::uint32_t node, int level, std::vector<std::uint32_t>& out) const
+{
+    const Node& n = nodes[node];
+    if (level == 0)
+    {
+        out.push_back(n.id);
+        return;
+    }
+
+    for (std::uint32_t c : n.children)
+        if (c != NO_NODE)
+            collectIds(c, level - 1, out);
+}
+
+/* -------------------------- */
+/* Window queries: a cell entirely inside or outside the square */
+/* [center - radius, center + radius] is decided without descending */
+/* -------------------------- */
+void ChunkQuadtree::collectOutside(glm::ivec2 center, int radius, std::vector<glm::ivec2>& out) const
+{
+    for (const auto& tile : tiles)
+        collectWindow(tile.second, { tile.first * TILE_CHUNKS, TILE_LEVELS }, center, radius, false, out);
+}
+
+void ChunkQuadtree::collectWithin(glm::ivec2 center, int radius, std::vector<glm::ivec2>& out) const
+{
+    for (const auto& tile : tiles)
+        collectWindow(tile.second, { tile.first * TILE_CHUNKS, TILE_LEVELS }, center, radius, true, out);
+}
+
+void ChunkQuadtree::collectWindow(std::uint32_t node, const Cell& cell, glm::ivec2 center, int radius, bool inside,
+    std::vector<glm::ivec2>& out) const
+{
+    glm::ivec2 lo = cell.origin;
+    glm::ivec2 hi = cell.origin + glm::ivec2((1 << cell.level) - 1);
+    glm::ivec2 windowLo = center - glm::ivec2(radius);
+    glm::ivec2 windowHi = center + glm::ivec2(radius);
+
+    bool disjoint = hi.x < windowLo.x || lo.x > windowHi.x || hi.y < windowLo.y || lo.y > windowHi.y;
+    bool contained = lo.x >= windowLo.x && hi.x <= windowHi.x && lo.y >= windowLo.y && hi.y <= windowHi.y;
+
+    if (disjoint || contained)
+    {
+        if (contained == inside)
+            collectAll(node, cell, out);
+        return;
+    }
+
+    const Node& n = nodes[node];
+    for (int q = 0; q < 4; ++q)
+        if (n.children[q] != NO_NODE)
+            collectWindow(n.children[q], child(cell, q), center, radius, inside, out);
+}
+
+void ChunkQuadtree::collectAll(std::uint32_t node, const Cell& cell, std::vector<glm::ivec2>& out) const
+{
+    if (cell.level == 0)
+    {
+        out.push_back(cell.origin);
+        return;
+    }
+
+    const Node& n = nodes[node];
+    for (int q = 0; q < 4; ++q)
+        if (n.children[q] != NO_NODE)
+            collectAll(n.children[q], child(cell, q), out);
+}
@@ -0,0 +1,59 @@
+#include "../include/DensityGrid.h"
+#include <cstdint>
+
+/* -------------------------- */
+/* DensityGrid Constructor */
+/* Lays the padded field out in the requested axis order */
+/* -------------------------- */
+DensityGrid::DensityGrid(int sizeX, int sizeY, int sizeZ, AxisOrder order)
+    : axisOrder(order)
+{
+    // One-voxel apron on both sides of every axis
+    std::ptrdiff_t dim[3] = { sizeX + 2, sizeY + 2, sizeZ + 2 };
+    std::ptrdiff_t stride[3];
+
+    // Axes listed slowest to fastest varying
+    int axes[3] = { 0, 1, 2 };
+    switch (order)
+    {
+    case AxisOrder::XYZ: break;
+    case AxisOrder::XZY: axes[0] = 0; axes[1] = 2; axes[2] = 1; break;
+    case AxisOrder::YXZ: axes[0] = 1; axes[1] = 0; axes[2] = 2; break;
+    case AxisOrder::YZX: axes[0] = 1; axes[1] = 2; axes[2] = 0; break;
+    case AxisOrder::ZXY: axes[0] = 2; axes[1] = 0; axes[2] = 1; break;
+    case AxisOrder::ZYX: axes[0] = 2; axes[1] = 1; axes[2] = 0; break;
+    }
+
+    stride[axes[2]] = 1;
+    stride[axes[1]] = dim[axes[2]];
+    stride[axes[0]] = dim[axes[2]] * dim[axes[1]];
+
+    strideX = stride[0];
+    strideY = stride[1];
+    strideZ = stride[2];
+    origin = strideX + strideY + strideZ;  // Skip the apron
+    count = std::size_t(dim[0] * dim[1] * dim[2]);
+
+    // Over-allocate by one cache line and start at the first aligned float
+    const std::size_t slack = ALIGNMENT / sizeof(float) - 1;
+    storage.reset(new float[count + slack]);
+
+    std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(storage.get());
+    std::uintptr_t aligned = (addr + ALIGNMENT - 1) & ~std::uintptr_t(ALIGNMENT - 1);
+    data = reinterpret_cast<float*>(aligned);
+}
+
+/* -------------------------- */
+/* Corner offsets of a marching cube in this layout */
+/* -------------------------- */
+void DensityGrid::cornerOffsets(std::ptrdiff_t out[8]) const
+{
+    out[0] = 0;
+    out[1] = strideX;
+    out[2] = strideX + strideZ;
+    out[3] = strideZ;
+    out[4] = strideY;
+    out[5] = strideX + strideY;
+    out[6] = strideX + strideY + strideZ;
+    out[7] = strideY + strideZ;
+}
@@ -0,0 +1,26 @@
+#include "../include/DrawCommandList.h"
+
+void DrawCommandList::clear()
+{
+    // Keeps capacity: the list is rebuilt every frame
+    indirect.clear();
+    drawCounts.clear();
+    offsets.clear();
+    bases.clear();
+    culled = 0;
+    triangles = 0;
+}
+
+void DrawCommandList::add(unsigned indexCount, std::size_t firstIndex, int baseVertex)
+{
+    if (indexCount == 0)
+        return;
+
+    indirect.push_back({ indexCount, 1u, std::uint32_t(firstIndex), baseVertex, 0u });
+
+    drawCounts.push_back(int(indexCount));
+    offsets.push_back(reinterpret_cast<const void*>(firstIndex * sizeof(unsigned int)));
+    bases.push_back(baseVertex);
+
+    triangles += indexCount / 3;
+}
@@ -0,0 +1,39 @@
+#include "../include/Frustum.h"
+#include <glm/gtc/matrix_access.hpp>
+
+/* -------------------------- */
+/* Frustum */
+/* -------------------------- */
+Frustum::Frustum(const glm::mat4& viewProj)
+{
+    planes[0] = glm::row(viewProj, 3) + glm::row(viewProj, 0); // Left
+    planes[1] = glm::row(viewProj, 3) - glm::row(viewProj, 0); // Right
+    planes[2] = glm::row(viewProj, 3) + glm::row(viewProj, 1); // Bottom
+    planes[3] = glm::row(viewProj, 3) - glm::row(viewProj, 1); // Top
+    planes[4] = glm::row(viewProj, 3) + glm::row(viewProj, 2); // Near
+    planes[5] = glm::row(viewProj, 3) - glm::row(viewProj, 2); // Far
+
+    for (int i = 0; i < 6; ++i)
+    {
+        float length = glm::length(glm::vec3(planes[i]));
+        if (length > 0.0001f)
+            planes[i] /= length;
+        absNormals[i] = glm::abs(glm::vec3(planes[i]));
+    }
+}
+
+bool Frustum::intersects(const glm::vec3& minCorner, const glm::vec3& maxCorner) const
+{
+    glm::vec3 center = (minCorner + maxCorner) * 0.5f;
+    glm::vec3 extents = (maxCorner - minCorner) * 0.5f;
+
+    for (int i = 0; i < 6; ++i)
+    {
+        // Signed distance of the centre plus the box's projected radius
+        float s = glm::dot(glm::vec3(planes[i]), center) + planes[i].w;
+        float r = glm::dot(absNormals[i], extents);
+        if (s + r < 0.0f)
+            return false;
+    }
+    return true;
+}
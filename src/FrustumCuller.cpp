@@ -0,0 +1,186 @@
+#include "../include/FrustumCuller.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CULL_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#define CULL_TARGET(isa)
+#else
+#define CULL_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+/* -------------------------- */
+/* Kernels: test boxes [begin, end) and append the visible ids to out */
+/* Appending is branch-free: every id is written, the count only */
+/* advances for visible ones, so out needs room for end - begin ids */
+/* -------------------------- */
+struct BoxArrays
+{
+    const float *cx, *cy, *cz, *ex, *ey, *ez;
+    const std::uint32_t* ids;
+};
+
+static std::size_t cullScalar(const Frustum& f, const BoxArrays& b, std::size_t begin, std::size_t end, std::uint32_t* out)
+{
+    std::size_t n = 0;
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        bool inside = true;
+        for (int p = 0; p < 6; ++p)
+        {
+            const glm::vec4& plane = f.planes[p];
+            const glm::vec3& a = f.absNormals[p];
+            float s = plane.x * b.cx[i] + plane.y * b.cy[i] + plane.z * b.cz[i] + plane.w;
+            float r = a.x * b.ex[i] + a.y * b.ey[i] + a.z * b.ez[i];
+            inside &= s + r >= 0.0f;
+        }
+        out[n] = b.ids[i];
+        n += inside;
+    }
+    return n;
+}
+
+#ifdef CULL_X86
+// SSE2 is baseline on x64: 4 boxes per iteration
+static std::size_t cullSSE(const Frustum& f, const BoxArrays& b, std::size_t count, std::uint32_t* out)
+{
+    std::size_t n = 0, i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 cx = _mm_loadu_ps(b.cx + i), cy = _mm_loadu_ps(b.cy + i), cz = _mm_loadu_ps(b.cz + i);
+        __m128 ex = _mm_loadu_ps(b.ex + i), ey = _mm_loadu_ps(b.ey + i), ez = _mm_loadu_ps(b.ez + i);
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+        for (int p = 0; p < 6; ++p)
+        {
+            const glm::vec4& plane = f.planes[p];
+            const glm::vec3& a = f.absNormals[p];
+            __m128 s = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), cx), _mm_mul_ps(_mm_set1_ps(plane.y), cy)),
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.z), cz), _mm_set1_ps(plane.w)));
+            __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(a.x), ex), _mm_mul_ps(_mm_set1_ps(a.y), ey)),
+                _mm_mul_ps(_mm_set1_ps(a.z), ez));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(s, r), _mm_setzero_ps()));
+        }
+
+        int mask = _mm_movemask_ps(inside);
+        for (int k = 0; k < 4; ++k)
+        {
+            out[n] = b.ids[i + k];
+            n += (mask >> k) & 1;
+        }
+    }
+    return n + cullScalar(f, b, i, count, out + n);
+}
+
+// 8 boxes per iteration; only needs AVX, which every AVX2 CPU has
+CULL_TARGET("avx")
+static std::size_t cullAVX(const Frustum& f, const BoxArrays& b, std::size_t count, std::uint32_t* out)
+{
+    std::size_t n = 0, i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 cx = _mm256_loadu_ps(b.cx + i), cy = _mm256_loadu_ps(b.cy + i), cz = _mm256_loadu_ps(b.cz + i);
+        __m256 ex = _mm256_loadu_ps(b.ex + i), ey = _mm256_loadu_ps(b.ey + i), ez = _mm256_loadu_ps(b.ez + i);
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+        for (int p = 0; p < 6; ++p)
+        {
+            const glm::vec4& plane = f.planes[p];
+            const glm::vec3& a = f.absNormals[p];
+            __m256 s = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.x), cx), _mm256_mul_ps(_mm256_set1_ps(plane.y), cy)),
+                _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.z), cz), _mm256_set1_ps(plane.w)));
+            __m256 r = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(a.x), ex), _mm256_mul_ps(_mm256_set1_ps(a.y), ey)),
+                _mm256_mul_ps(_mm256_set1_ps(a.z), ez));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(s, r), _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+
+        int mask = _mm256_movemask_ps(inside);
+        for (int k = 0; k < 8; ++k)
+        {
+            out[n] = b.ids[i + k];
+            n += (mask >> k) & 1;
+        }
+    }
+    return n + cullScalar(f, b, i, count, out + n);
+}
+#endif
+
+/* -------------------------- */
+/* FrustumCuller */
+/* -------------------------- */
+void FrustumCuller::set(std::uint32_t id, const glm::vec3& minCorner, const glm::vec3& maxCorner)
+{
+    if (id >= slotOf.size())
+        slotOf.resize(id + 1, NO_SLOT);
+
+    std::uint32_t slot = slotOf[id];
+    if (slot == NO_SLOT)
+    {
+        slot = std::uint32_t(ids.size());
+        slotOf[id] = slot;
+        ids.push_back(id);
+        centerX.push_back(0.0f); centerY.push_back(0.0f); centerZ.push_back(0.0f);
+        extentX.push_back(0.0f); extentY.push_back(0.0f); extentZ.push_back(0.0f);
+    }
+
+    glm::vec3 center = (minCorner + maxCorner) * 0.5f;
+    glm::vec3 extents = (maxCorner - minCorner) * 0.5f;
+    centerX[slot] = center.x; centerY[slot] = center.y; centerZ[slot] = center.z;
+    extentX[slot] = extents.x; extentY[slot] = extents.y; extentZ[slot] = extents.z;
+}
+
+void FrustumCuller::remove(std::uint32_t id)
+{
+    if (id >= slotOf.size() || slotOf[id] == NO_SLOT)
+        return;
+
+    // Move the last box into the hole
+    std::uint32_t slot = slotOf[id];
+    std::uint32_t last = std::uint32_t(ids.size() - 1);
+    if (slot != last)
+    {
+        ids[slot] = ids[last];
+        centerX[slot] = centerX[last]; centerY[slot] = centerY[last]; centerZ[slot] = centerZ[last];
+        extentX[slot] = extentX[last]; extentY[slot] = extentY[last]; extentZ[slot] = extentZ[last];
+        slotOf[ids[slot]] = slot;
+    }
+
+    ids.pop_back();
+    centerX.pop_back(); centerY.pop_back(); centerZ.pop_back();
+    extentX.pop_back(); extentY.pop_back(); extentZ.pop_back();
+    slotOf[id] = NO_SLOT;
+}
+
+void FrustumCuller::clear()
+{
+    centerX.clear(); centerY.clear(); centerZ.clear();
+    extentX.clear(); extentY.clear(); extentZ.clear();
+    ids.clear();
+    slotOf.clear();
+}
+
+void FrustumCuller::cull(const Frustum& frustum, std::vector<std::uint32_t>& visible) const
+{
+    static const SimdLevel level = detectSimdLevel();
+    cullLevel(level, frustum, visible);
+}
+
+void FrustumCuller::cullLevel(SimdLevel level, const Frustum& frustum, std::vector<std::uint32_t>& visible) const
+{
+    visible.resize(ids.size());
+    if (ids.empty())
+        return;
+
+    BoxArrays b = { centerX.data(), centerY.data(), centerZ.data(), extentX.data(), extentY.data(), extentZ.data(), ids.data() };
+    std::size_t n;
+    switch (level)
+    {
+#ifdef CULL_X86
+    case SimdLevel::AVX2: n = cullAVX(frustum, b, ids.size(), visible.data()); break;
+    case SimdLevel::SSE41: n = cullSSE(frustum, b, ids.size(), visible.data()); break;
+#endif
+    default: n = cullScalar(frustum, b, 0, ids.size(), visible.data()); break;
+    }
+    visible.resize(n);
+}
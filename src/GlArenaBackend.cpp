@@ -0,0 +1,153 @@
+#include "../include/GlArenaBackend.h"
+#include "../include/Mesh.h"
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <cstring>
+
+// Not in the GL 3.3 loader
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+
+typedef void (APIENTRYP PFNMULTIDRAWELEMENTSINDIRECT)(GLenum mode, GLenum type, const void* indirect, GLsizei drawCount, GLsizei stride);
+
+/* -------------------------- */
+/* GlArenaBackend Constructor */
+/* Indirect multi-draw is core in 4.3 and an extension before that */
+/* -------------------------- */
+GlArenaBackend::GlArenaBackend()
+{
+    GLint major = 0, minor = 0, extensions = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensions);
+
+    bool supported = major > 4 || (major == 4 && minor >= 3);
+    for (GLint i = 0; i < extensions && !supported; ++i)
+    {
+        const char* name = (const char*)glGetStringi(GL_EXTENSIONS, i);
+        supported = name && std::strcmp(name, "GL_ARB_multi_draw_indirect") == 0;
+    }
+
+    if (supported)
+        multiDrawIndirect = (void*)glfwGetProcAddress("glMultiDrawElementsIndirect");
+
+    if (multiDrawIndirect)
+        glGenBuffers(1, &indirectBuffer);
+}
+
+GlArenaBackend::~GlArenaBackend()
+{
+    if (indirectBuffer)
+        glDeleteBuffers(1, &indirectBuffer);
+}
+
+unsigned GlArenaBackend::createBuffer(BufferKind, std::size_t bytes)
+{
+    // Index buffers are bound through the VAO, so both kinds can use the
+    // copy-write target for allocation and updates
+    GLuint buffer;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, bytes, nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    return buffer;
+}
+
+void GlArenaBackend::destroyBuffer(unsigned buffer)
+{
+    GLuint id = buffer;
+    glDeleteBuffers(1, &id);
+}
+
+void GlArenaBackend::uploadBuffer(unsigned buffer, std::size_t offset, const void* data, std::size_t bytes)
+{
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, offset, bytes, data);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void GlArenaBackend::copyBuffer(unsigned src, std::size_t srcOffset, unsigned dst, std::size_t dstOffset, std::size_t bytes)
+{
+    glBindBuffer(GL_COPY_READ_BUFFER, src);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, dst);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, srcOffset, dstOffset, bytes);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+unsigned GlArenaBackend::createVertexArray(unsigned vertexBuffer, unsigned indexBuffer)
+{
+    GLuint vao;
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    Mesh::setPackedVertexLayout();
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return vao;
+}
+
+void GlArenaBackend::destroyVertexArray(unsigned vertexArray)
+{
+    GLuint id = vertexArray;
+    glDeleteVertexArrays(1, &id);
+}
+
+unsigned GlArenaBackend::createBufferTexture(unsigned buffer)
+{
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_BUFFER, texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, buffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    return texture;
+}
+
+void GlArenaBackend::destroyTexture(unsigned texture)
+{
+    GLuint id = texture;
+    glDeleteTextures(1, &id);
+}
+
+void GlArenaBackend::bindBufferTexture(unsigned texture)
+{
+    glActiveTexture(GL_TEXTURE0 + PAGE_TABLE_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, texture);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void GlArenaBackend::bindVertexArray(unsigned vertexArray)
+{
+    glBindVertexArray(vertexArray);
+}
+
+void GlArenaBackend::drawElementsBaseVertex(unsigned indexCount, std::size_t firstIndex, int baseVertex)
+{
+    glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT,
+        (void*)(firstIndex * sizeof(unsigned int)), baseVertex);
+}
+
+/* -------------------------- */
+/* One call for the whole command list */
+/* -------------------------- */
+void GlArenaBackend::multiDraw(const DrawCommandList& list)
+{
+    if (multiDrawIndirect)
+    {
+        // Orphan and refill the command buffer every frame
+        const std::vector<DrawElementsIndirectCommand>& commands = list.commands();
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, commands.size() * sizeof(DrawElementsIndirectCommand), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, commands.size() * sizeof(DrawElementsIndirectCommand), commands.data());
+        ((PFNMULTIDRAWELEMENTSINDIRECT)multiDrawIndirect)(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, GLsizei(commands.size()), 0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        return;
+    }
+
+    glMultiDrawElementsBaseVertex(GL_TRIANGLES, list.counts().data(), GL_UNSIGNED_INT,
+        list.indexOffsets().data(), GLsizei(list.drawCount()), list.baseVertices().data());
+}
@@ -0,0 +1,115 @@
+#include "../include/HeightTileCache.h"
+#include "../include/Chunk.h"
+#include <algorithm>
+
+// Floor division, so negative columns map to the tile on their left
+static int floorDiv(int a, int b)
+{
+    return (a >= 0 ? a : a - b + 1) / b;
+}
+
+/* -------------------------- */
+/* HeightTileCache Constructor */
+/* Capacity is split evenly across the shards */
+/* -------------------------- */
+HeightTileCache::HeightTileCache(const BiomeManager* biomeMgr, std::size_t capacityTiles)
+    : biome(biomeMgr),
+      shardCapacity(std::max<std::size_t>(1, capacityTiles / SHARD_COUNT))
+{
+}
+
+HeightTileCache::Shard& HeightTileCache::shardFor(glm::ivec2 coord)
+{
+    return shards[Vec2Hash()(coord) % SHARD_COUNT];
+}
+
+/* -------------------------- */
+/* Sample a whole tile with one batched BiomeManager call */
+/* -------------------------- */
+std::shared_ptr<const HeightTile> HeightTileCache::compute(glm::ivec2 coord) const
+{
+    auto tile = std::make_shared<HeightTile>();
+    tile->coord = coord;
+
+    glm::vec2 origin(float(coord.x * HeightTile::SIZE * VOXEL_SIZE),
+        float(coord.y * HeightTile::SIZE * VOXEL_SIZE));
+    biome->sampleGrid(origin, float(VOXEL_SIZE), HeightTile::SIZE, HeightTile::SIZE, tile->samples);
+
+    return tile;
+}
+
+/* -------------------------- */
+/* Look up a tile, computing it outside the lock on a miss */
+/* -------------------------- */
+std::shared_ptr<const HeightTile> HeightTileCache::get(glm::ivec2 coord)
+{
+    Shard& shard = shardFor(coord);
+
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(coord);
+        if (it != shard.index.end())
+        {
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+            hitCount.fetch_add(1, std::memory_order_relaxed);
+            return *it->second;
+        }
+    }
+
+    missCount.fetch_add(1, std::memory_order_relaxed);
+    std::shared_ptr<const HeightTile> tile = compute(coord);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // Another worker may have inserted the same tile meanwhile; keep theirs
+    auto it = shard.index.find(coord);
+    if (it != shard.index.end())
+        return *it->second;
+
+    shard.lru.push_front(tile);
+    shard.index[coord] = shard.lru.begin();
+
+    // Evict least recently used tiles; readers holding them keep them alive
+    while (shard.lru.size() > shardCapacity)
+    {
+        shard.index.erase(shard.lru.back()->coord);
+        shard.lru.pop_back();
+    }
+
+    return tile;
+}
+
+/* -------------------------- */
+/* Copy a window of columns, spanning as many tiles as needed */
+/* -------------------------- */
+void HeightTileCache::fillColumns(int x0, int z0, int nx, int nz, BiomeSample* out)
+{
+    const int S = HeightTile::SIZE;
+
+    for (int tx = floorDiv(x0, S); tx <= floorDiv(x0 + nx - 1, S); ++tx)
+        for (int tz = floorDiv(z0, S); tz <= floorDiv(z0 + nz - 1, S); ++tz)
+        {
+            std::shared_ptr<const HeightTile> tile = get(glm::ivec2(tx, tz));
+
+            // Overlap of this tile with the window, in world columns
+            int xBegin = std::max(x0, tx * S), xEnd = std::min(x0 + nx, (tx + 1) * S);
+            int zBegin = std::max(z0, tz * S), zEnd = std::min(z0 + nz, (tz + 1) * S);
+
+            for (int x = xBegin; x < xEnd; ++x)
+            {
+                const BiomeSample* src = &tile->samples[(x - tx * S) * S + (zBegin - tz * S)];
+                std::copy(src, src + (zEnd - zBegin), &out[(x - x0) * nz + (zBegin - z0)]);
+            }
+        }
+}
+
+std::size_t HeightTileCache::size() const
+{
+    std::size_t total = 0;
+    for (const Shard& shard : shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        total += shard.lru.size();
+    }
+    return total;
+}
@@ -0,0 +1,209 @@
+#include "../include/JobSystem.h"
+#include <algorithm>
+#include <chrono>
+
+// Worker identity of the calling thread, so jobs can queue follow-up work locally
+static thread_local const JobSystem* tlsOwner = nullptr;
+static thread_local int tlsWorker = -1;
+
+/* -------------------------- */
+/* JobSystem Constructor / Destructor */
+/* -------------------------- */
+JobSystem::JobSystem(int threadCount)
+{
+    if (threadCount <= 0)
+        threadCount = int(std::max(1u, std::thread::hardware_concurrency()));
+
+    for (int i = 0; i < threadCount; ++i)
+        queues.push_back(std::make_unique<WorkerQueue>());
+
+    for (int i = 0; i < threadCount; ++i)
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+
+    for (auto& worker : workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+}
+
+/* -------------------------- */
+/* Submission */
+/* -------------------------- */
+int JobSystem::targetQueue()
+{
+    if (tlsOwner == this)
+        return tlsWorker;
+
+    return int(nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size());
+}
+
+void JobSystem::push(int queue, Job&& job, int priority)
+{
+    priority = std::min(std::max(priority, 0), PRIORITY_LEVELS - 1);
+
+    WorkerQueue& q = *queues[queue];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    q.buckets[priority].push_back(std::move(job));
+    q.size.fetch_add(1, std::memory_order_relaxed);
+}
+
+void JobSystem::submit(Job job, int priority)
+{
+    unfinished.fetch_add(1);
+    push(targetQueue(), std::move(job), priority);
+    queued.fetch_add(1);
+
+    // Taking the lock orders this wake-up after a worker's predicate check
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    wakeCondition.notify_one();
+}
+
+void JobSystem::submitBatch(std::vector<PrioritizedJob>&& jobs)
+{
+    if (jobs.empty())
+        return;
+
+    unfinished.fetch_add(int(jobs.size()));
+    for (PrioritizedJob& j : jobs)
+        push(targetQueue(), std::move(j.job), j.priority);
+    queued.fetch_add(int(jobs.size()));
+
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    if (jobs.size() == 1)
+        wakeCondition.notify_one();
+    else
+        wakeCondition.notify_all();  // A burst should wake every idle worker
+
+    jobs.clear();
+}
+
+/* -------------------------- */
+/* Fetching work: own deques front-first, then steal from the back of others */
+/* -------------------------- */
+bool JobSystem::popLocal(int index, Job& job)
+{
+    WorkerQueue& q = *queues[index];
+    if (q.size.load(std::memory_order_relaxed) == 0)
+        return false;
+
+    std::lock_guard<std::mutex> lock(q.mutex);
+
+    for (auto& bucket : q.buckets)
+    {
+        if (!bucket.empty())
+        {
+            job = std::move(bucket.front());
+            bucket.pop_front();
+            q.size.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobSystem::steal(int index, Job& job)
+{
+    const int count = int(queues.size());
+
+    // Take the most urgent job found across all victims
+    for (int level = 0; level < PRIORITY_LEVELS; ++level)
+    {
+        for (int k = 1; k < count; ++k)
+        {
+            WorkerQueue& victim = *queues[(index + k) % count];
+            if (victim.size.load(std::memory_order_relaxed) == 0)
+                continue;
+
+            std::lock_guard<std::mutex> lock(victim.mutex);
+
+            auto& bucket = victim.buckets[level];
+            if (!bucket.empty())
+            {
+                job = std::move(bucket.back());
+                bucket.pop_back();
+                victim.size.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/* -------------------------- */
+/* Worker thread loop */
+/* -------------------------- */
+void JobSystem::workerLoop(int index)
+{
+    tlsOwner = this;
+    tlsWorker = index;
+    WorkerQueue& self = *queues[index];
+
+    while (true)
+    {
+        Job job;
+        bool stole = false;
+
+        if (!popLocal(index, job))
+            stole = steal(index, job);
+
+        if (!job)
+        {
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wakeCondition.wait(lock, [this] { return queued.load() > 0 || stopping; });
+
+            if (stopping)
+                return;
+            continue;
+        }
+
+        queued.fetch_sub(1);
+
+        auto start = std::chrono::steady_clock::now();
+        job();
+        auto end = std::chrono::steady_clock::now();
+
+        self.executed.fetch_add(1, std::memory_order_relaxed);
+        if (stole)
+            self.stolen.fetch_add(1, std::memory_order_relaxed);
+        self.busyNanos.fetch_add(std::uint64_t(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()),
+            std::memory_order_relaxed);
+
+        if (unfinished.fetch_sub(1) == 1)
+        {
+            { std::lock_guard<std::mutex> lock(sleepMutex); }
+            idleCondition.notify_all();
+        }
+    }
+}
+
+/* -------------------------- */
+/* Idle wait and statistics */
+/* -------------------------- */
+void JobSystem::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    idleCondition.wait(lock, [this] { return unfinished.load() == 0; });
+}
+
+JobSystem::Stats JobSystem::stats() const
+{
+    Stats s;
+    for (const auto& q : queues)
+    {
+        s.executed += q->executed.load(std::memory_order_relaxed);
+        s.stolen += q->stolen.load(std::memory_order_relaxed);
+        s.busySeconds += q->busyNanos.load(std::memory_order_relaxed) * 1e-9;
+    }
+    return s;
+}
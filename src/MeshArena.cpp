@@ -0,0 +1,357 @@
+#include "../include/MeshArena.h"
+#include <algorithm>
+#include <iterator>
+
+#define ARENA_COMPACT_MAX_OCCUPANCY 0.75   // Grow instead of compacting above this fill ratio
+
+/* -------------------------- */
+/* RangeAllocator */
+/* -------------------------- */
+RangeAllocator::RangeAllocator(std::size_t capacity)
+    : total(0)
+{
+    grow(capacity);
+}
+
+std::size_t RangeAllocator::allocate(std::size_t size)
+{
+    if (size == 0)
+        return INVALID;
+
+    // First fit keeps live ranges packed towards the start of the buffer
+    for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it)
+    {
+        if (it->second < size)
+            continue;
+
+        std::size_t offset = it->first;
+        std::size_t remaining = it->second - size;
+        freeRanges.erase(it);
+        if (remaining > 0)
+            freeRanges[offset + size] = remaining;
+
+        freeTotal -= size;
+        return offset;
+    }
+    return INVALID;
+}
+
+void RangeAllocator::release(std::size_t offset, std::size_t size)
+{
+    if (size == 0)
+        return;
+
+    freeTotal += size;
+    auto next = freeRanges.lower_bound(offset);
+
+    // Merge with the following range
+    if (next != freeRanges.end() && offset + size == next->first)
+    {
+        size += next->second;
+        next = freeRanges.erase(next);
+    }
+
+    // Merge with the preceding range
+    if (next != freeRanges.begin())
+    {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset)
+        {
+            prev->second += size;
+            return;
+        }
+    }
+
+    freeRanges[offset] = size;
+}
+
+void RangeAllocator::grow(std::size_t newCapacity)
+{
+    if (newCapacity <= total)
+        return;
+
+    std::size_t oldTotal = total;
+    total = newCapacity;
+    release(oldTotal, newCapacity - oldTotal);
+}
+
+void RangeAllocator::resetPacked(std::size_t used)
+{
+    freeRanges.clear();
+    freeTotal = 0;
+    if (used < total)
+    {
+        freeRanges[used] = total - used;
+        freeTotal = total - used;
+    }
+}
+
+std::size_t RangeAllocator::largestFree() const
+{
+    std::size_t largest = 0;
+    for (const auto& range : freeRanges)
+        largest = std::max(largest, range.second);
+    return largest;
+}
+
+double RangeAllocator::fragmentation() const
+{
+    if (freeTotal == 0)
+        return 0.0;
+    return 1.0 - double(largestFree()) / double(freeTotal);
+}
+
+/* -------------------------- */
+/* MeshArena Constructor */
+/* -------------------------- */
+MeshArena::MeshArena(ArenaBackend* backend, std::size_t initialVertices, std::size_t initialIndices)
+    : backend(backend),
+      vertexRanges(pagesFor(initialVertices)),
+      indexRanges(initialIndices)
+{
+    vertexBuffer = backend->createBuffer(ArenaBackend::BufferKind::Vertex, vertexRanges.capacity() * PAGE_VERTICES * sizeof(PackedVertex));
+    indexBuffer = backend->createBuffer(ArenaBackend::BufferKind::Index, initialIndices * sizeof(unsigned int));
+    vertexArray = backend->createVertexArray(vertexBuffer, indexBuffer);
+    createPageTable();
+}
+
+MeshArena::~MeshArena()
+{
+    backend->destroyTexture(pageTexture);
+    backend->destroyBuffer(pageBuffer);
+    backend->destroyVertexArray(vertexArray);
+    backend->destroyBuffer(vertexBuffer);
+    backend->destroyBuffer(indexBuffer);
+}
+
+void MeshArena::createPageTable()
+{
+    pageOrigins.assign(vertexRanges.capacity(), glm::vec4(0.0f));
+    pageBuffer = backend->createBuffer(ArenaBackend::BufferKind::PageTable, pageOrigins.size() * sizeof(glm::vec4));
+    pageTexture = backend->createBufferTexture(pageBuffer);
+    dirtyBegin = 0;
+    dirtyEnd = 0;
+}
+
+void MeshArena::writePages(const Slot& slot)
+{
+    std::size_t first = slot.pageOffset;
+    std::size_t last = first + pagesFor(slot.vertexCount);
+    for (std::size_t page = first; page < last; ++page)
+        pageOrigins[page] = glm::vec4(slot.origin, 0.0f);
+
+    if (dirtyBegin == dirtyEnd)
+    {
+        dirtyBegin = first;
+        dirtyEnd = last;
+    }
+    else
+    {
+        dirtyBegin = std::min(dirtyBegin, first);
+        dirtyEnd = std::max(dirtyEnd, last);
+    }
+}
+
+/* -------------------------- */
+/* Upload a mesh into free ranges of both buffers */
+/* -------------------------- */
+MeshHandle MeshArena::allocate(const std::vector<PackedVertex>& vertices, const std::vector<unsigned int>& indices,
+    const glm::vec3& origin)
+{
+    return allocate(vertices.data(), vertices.size(), indices.data(), indices.size(), origin);
+}
+
+MeshHandle MeshArena::allocate(const PackedVertex* vertices, std::size_t vertexCount,
+    const unsigned int* indices, std::size_t indexCount, const glm::vec3& origin)
+{
+    if (vertexCount == 0 || indexCount == 0)
+        return INVALID_MESH;
+
+    std::size_t pageCount = pagesFor(vertexCount);
+    std::size_t pageOffset = vertexRanges.allocate(pageCount);
+    std::size_t indexOffset = indexRanges.allocate(indexCount);
+
+    if (pageOffset == RangeAllocator::INVALID || indexOffset == RangeAllocator::INVALID)
+    {
+        // Undo the half that fitted, make room, then retry (cannot fail after reserve)
+        if (pageOffset != RangeAllocator::INVALID)
+            vertexRanges.release(pageOffset, pageCount);
+        if (indexOffset != RangeAllocator::INVALID)
+            indexRanges.release(indexOffset, indexCount);
+
+        reserve(pageCount, indexCount);
+        pageOffset = vertexRanges.allocate(pageCount);
+        indexOffset = indexRanges.allocate(indexCount);
+    }
+
+    backend->uploadBuffer(vertexBuffer, pageOffset * PAGE_VERTICES * sizeof(PackedVertex),
+        vertices, vertexCount * sizeof(PackedVertex));
+    backend->uploadBuffer(indexBuffer, indexOffset * sizeof(unsigned int),
+        indices, indexCount * sizeof(unsigned int));
+
+    MeshHandle handle;
+    if (!freeSlots.empty())
+    {
+        handle = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else
+    {
+        slots.push_back({});
+        handle = MeshHandle(slots.size());
+    }
+
+    Slot& slot = slots[handle - 1];
+    slot = { pageOffset, vertexCount, indexOffset, indexCount, origin, true };
+    writePages(slot);
+    return handle;
+}
+
+void MeshArena::release(MeshHandle handle)
+{
+    if (handle == INVALID_MESH)
+        return;
+
+    // The page table entries are left stale; nothing draws those pages
+    Slot& slot = slots[handle - 1];
+    vertexRanges.release(slot.pageOffset, pagesFor(slot.vertexCount));
+    indexRanges.release(slot.indexOffset, slot.indexCount);
+    slot.live = false;
+    freeSlots.push_back(handle);
+}
+
+MeshArena::DrawRange MeshArena::range(MeshHandle handle) const
+{
+    const Slot& slot = slots[handle - 1];
+    return { unsigned(slot.indexCount), slot.indexOffset, int(slot.pageOffset * PAGE_VERTICES) };
+}
+
+void MeshArena::bind()
+{
+    if (dirtyBegin != dirtyEnd)
+    {
+        backend->uploadBuffer(pageBuffer, dirtyBegin * sizeof(glm::vec4),
+            &pageOrigins[dirtyBegin], (dirtyEnd - dirtyBegin) * sizeof(glm::vec4));
+        dirtyBegin = dirtyEnd = 0;
+    }
+
+    backend->bindVertexArray(vertexArray);
+    backend->bindBufferTexture(pageTexture);
+}
+
+void MeshArena::draw(MeshHandle handle) const
+{
+    if (handle == INVALID_MESH)
+        return;
+
+    DrawRange r = range(handle);
+    backend->drawElementsBaseVertex(r.indexCount, r.firstIndex, r.baseVertex);
+}
+
+void MeshArena::submit(const DrawCommandList& list) const
+{
+    if (list.drawCount() > 0)
+        backend->multiDraw(list);
+}
+
+void MeshArena::defragment()
+{
+    relocate(vertexRanges.capacity(), indexRanges.capacity());
+    defragCount++;
+}
+
+/* -------------------------- */
+/* Compact when that leaves comfortable headroom, otherwise grow. */
+/* Compacting a nearly full arena would only buy a few allocations */
+/* before the next compaction */
+/* -------------------------- */
+void MeshArena::reserve(std::size_t pageCount, std::size_t indexCount)
+{
+    bool vertexTight = double(vertexRanges.used() + pageCount) > ARENA_COMPACT_MAX_OCCUPANCY * vertexRanges.capacity();
+    bool indexTight = double(indexRanges.used() + indexCount) > ARENA_COMPACT_MAX_OCCUPANCY * indexRanges.capacity();
+
+    if (!vertexTight && !indexTight)
+    {
+        defragment();
+        return;
+    }
+
+    // Double the buffer that is short (at least enough for this mesh)
+    std::size_t pageCapacity = vertexRanges.capacity();
+    std::size_t indexCapacity = indexRanges.capacity();
+    if (vertexTight)
+        pageCapacity = std::max(pageCapacity * 2, vertexRanges.used() + pageCount);
+    if (indexTight)
+        indexCapacity = std::max(indexCapacity * 2, indexRanges.used() + indexCount);
+
+    relocate(pageCapacity, indexCapacity);
+    growCount++;
+}
+
+/* -------------------------- */
+/* Copy live meshes, packed, into new buffers and swap them in */
+/* GPU-to-GPU copies only; the CPU copy of each mesh is long gone */
+/* -------------------------- */
+void MeshArena::relocate(std::size_t pageCapacity, std::size_t indexCapacity)
+{
+    const std::size_t pageBytes = PAGE_VERTICES * sizeof(PackedVertex);
+    unsigned newVertexBuffer = backend->createBuffer(ArenaBackend::BufferKind::Vertex, pageCapacity * pageBytes);
+    unsigned newIndexBuffer = backend->createBuffer(ArenaBackend::BufferKind::Index, indexCapacity * sizeof(unsigned int));
+
+    std::size_t pageCursor = 0, indexCursor = 0;
+    for (Slot& slot : slots)
+    {
+        if (!slot.live)
+            continue;
+
+        backend->copyBuffer(vertexBuffer, slot.pageOffset * pageBytes,
+            newVertexBuffer, pageCursor * pageBytes, slot.vertexCount * sizeof(PackedVertex));
+        backend->copyBuffer(indexBuffer, slot.indexOffset * sizeof(unsigned int),
+            newIndexBuffer, indexCursor * sizeof(unsigned int), slot.indexCount * sizeof(unsigned int));
+        movedBytes += slot.vertexCount * sizeof(PackedVertex) + slot.indexCount * sizeof(unsigned int);
+
+        slot.pageOffset = pageCursor;
+        slot.indexOffset = indexCursor;
+        pageCursor += pagesFor(slot.vertexCount);
+        indexCursor += slot.indexCount;
+    }
+
+    backend->destroyTexture(pageTexture);
+    backend->destroyBuffer(pageBuffer);
+    backend->destroyVertexArray(vertexArray);
+    backend->destroyBuffer(vertexBuffer);
+    backend->destroyBuffer(indexBuffer);
+
+    vertexBuffer = newVertexBuffer;
+    indexBuffer = newIndexBuffer;
+    vertexArray = backend->createVertexArray(vertexBuffer, indexBuffer);
+
+    vertexRanges.grow(pageCapacity);
+    indexRanges.grow(indexCapacity);
+    vertexRanges.resetPacked(pageCursor);
+    indexRanges.resetPacked(indexCursor);
+
+    // Every page moved: rebuild the whole table
+    createPageTable();
+    for (const Slot& slot : slots)
+        if (slot.live)
+            writePages(slot);
+}
+
+MeshArena::Stats MeshArena::stats() const
+{
+    Stats s;
+    s.liveMeshes = slots.size() - freeSlots.size();
+    s.vertexCapacity = vertexRanges.capacity() * PAGE_VERTICES;
+    s.vertexUsed = vertexRanges.used() * PAGE_VERTICES;
+    s.indexCapacity = indexRanges.capacity();
+    s.indexUsed = indexRanges.used();
+    s.vertexFreeBlocks = vertexRanges.freeBlocks();
+    s.indexFreeBlocks = indexRanges.freeBlocks();
+    s.vertexFragmentation = vertexRanges.fragmentation();
+    s.indexFragmentation = indexRanges.fragmentation();
+    s.grows = growCount;
+    s.defragments = defragCount;
+    s.bytesMoved = movedBytes;
+    return s;
+}
@@ -0,0 +1,147 @@
+#include "../include/MeshBlob.h"
+#include <cstring>
+
+static const char MESH_BLOB_MAGIC[4] = { 'T', 'R', 'M', 'B' };
+
+static const std::uint64_t PRIME1 = 0x9E3779B185EBCA87ull;
+static const std::uint64_t PRIME2 = 0xC2B2AE3D27D4EB4Full;
+
+static std::uint64_t rotl(std::uint64_t v, int r)
+{
+    return (v << r) | (v >> (64 - r));
+}
+
+static std::size_t alignUp(std::size_t v)
+{
+    return (v + MESH_BLOB_ALIGNMENT - 1) / MESH_BLOB_ALIGNMENT * MESH_BLOB_ALIGNMENT;
+}
+
+/* ------------------------- */
+/* Payload checksum: xxHash64's round on four independent lanes of */
+/* 64-bit words, so it runs near memory speed (not xxHash64-compatible) */
+/* ------------------------- */
+static std::uint64_t checksumBytes(const void* data, std::size_t bytes, std::uint64_t seed)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    std::uint64_t lane[4] = { seed + PRIME1 + PRIME2, seed + PRIME2, seed, seed - PRIME1 };
+    std::size_t remaining = bytes;
+
+    while (remaining >= 32)
+    {
+        for (int k = 0; k < 4; ++k)
+        {
+            std::uint64_t w;
+            std::memcpy(&w, p + 8 * k, sizeof(w));
+            lane[k] = rotl(lane[k] + w * PRIME2, 31) * PRIME1;
+        }
+        p += 32;
+        remaining -= 32;
+    }
+
+    std::uint64_t h = rotl(lane[0], 1) + rotl(lane[1], 7) + rotl(lane[2], 12) + rotl(lane[3], 18) + bytes;
+    while (remaining >= 8)
+    {
+        std::uint64_t w;
+        std::memcpy(&w, p, sizeof(w));
+        h = rotl(h ^ (rotl(w * PRIME2, 31) * PRIME1), 27) * PRIME1 + PRIME2;
+        p += 8;
+        remaining -= 8;
+    }
+    while (remaining > 0)
+    {
+        h = rotl(h ^ (*p * PRIME1), 11) * PRIME2;
+        ++p;
+        --remaining;
+    }
+
+    // Final avalanche
+    h ^= h >> 33;
+    h *= PRIME2;
+    h ^= h >> 29;
+    return h;
+}
+
+// Header (checksum zeroed), then both payloads
+static std::uint64_t blobChecksum(const MeshBlobHeader& header,
+    const PackedVertex* vertices, const unsigned int* indices)
+{
+    MeshBlobHeader h = header;
+    h.checksum = 0;
+    std::uint64_t sum = checksumBytes(&h, sizeof(h), 0);
+    sum = checksumBytes(vertices, header.vertexCount * sizeof(PackedVertex), sum);
+    return checksumBytes(indices, header.indexCount * sizeof(unsigned int), sum);
+}
+
+std::size_t MeshBlobView::payloadBytes() const
+{
+    return vertexCount() * sizeof(PackedVertex) + indexCount() * sizeof(unsigned int);
+}
+
+MeshBlobHeader makeMeshBlobHeader(const Chunk::MeshInfo& info,
+    const PackedVertex* vertices, std::size_t vertexCount,
+    const unsigned int* indices, std::size_t indexCount)
+{
+    MeshBlobHeader header = {};
+    std::memcpy(header.magic, MESH_BLOB_MAGIC, sizeof(MESH_BLOB_MAGIC));
+    header.version = MESH_BLOB_VERSION;
+    header.vertexStride = sizeof(PackedVertex);
+    header.vertexCount = std::uint32_t(vertexCount);
+    header.indexCount = std::uint32_t(indexCount);
+    header.vertexOffset = std::uint32_t(alignUp(sizeof(MeshBlobHeader)));
+    header.indexOffset = std::uint32_t(alignUp(header.vertexOffset + vertexCount * sizeof(PackedVertex)));
+    header.info = info;
+    header.checksum = blobChecksum(header, vertices, indices);
+    return header;
+}
+
+std::size_t meshBlobBytes(const MeshBlobHeader& header)
+{
+    return header.indexOffset + std::size_t(header.indexCount) * sizeof(unsigned int);
+}
+
+void serializeMeshBlob(const Chunk::MeshInfo& info,
+    const std::vector<PackedVertex>& vertices, const std::vector<unsigned int>& indices,
+    std::vector<unsigned char>& out)
+{
+    MeshBlobHeader header = makeMeshBlobHeader(info, vertices.data(), vertices.size(), indices.data(), indices.size());
+    out.assign(meshBlobBytes(header), 0);
+    std::memcpy(out.data(), &header, sizeof(header));
+    if (!vertices.empty())
+        std::memcpy(out.data() + header.vertexOffset, vertices.data(), vertices.size() * sizeof(PackedVertex));
+    if (!indices.empty())
+        std::memcpy(out.data() + header.indexOffset, indices.data(), indices.size() * sizeof(unsigned int));
+}
+
+/* ------------------------- */
+/* Validate a blob in place */
+/* Every size is checked before the checksum reads the payloads, so a */
+/* damaged header cannot send the read outside data */
+/* ------------------------- */
+bool readMeshBlob(const void* data, std::size_t bytes, MeshBlobView& out)
+{
+    const unsigned char* base = static_cast<const unsigned char*>(data);
+    if (bytes < sizeof(MeshBlobHeader) || reinterpret_cast<std::uintptr_t>(base) % alignof(MeshBlobHeader) != 0)
+        return false;
+
+    const MeshBlobHeader* header = reinterpret_cast<const MeshBlobHeader*>(base);
+    if (std::memcmp(header->magic, MESH_BLOB_MAGIC, sizeof(MESH_BLOB_MAGIC)) != 0
+        || header->version != MESH_BLOB_VERSION || header->vertexStride != sizeof(PackedVertex))
+        return false;
+
+    // Offsets must be the ones the writer computes, which also makes them aligned
+    std::uint64_t vertexEnd = std::uint64_t(header->vertexOffset) + std::uint64_t(header->vertexCount) * sizeof(PackedVertex);
+    std::uint64_t indexEnd = std::uint64_t(header->indexOffset) + std::uint64_t(header->indexCount) * sizeof(unsigned int);
+    if (header->vertexOffset != alignUp(sizeof(MeshBlobHeader)) || header->indexOffset != alignUp(std::size_t(vertexEnd))
+        || indexEnd > bytes)
+        return false;
+
+    const PackedVertex* vertices = reinterpret_cast<const PackedVertex*>(base + header->vertexOffset);
+    const unsigned int* indices = reinterpret_cast<const unsigned int*>(base + header->indexOffset);
+    if (blobChecksum(*header, vertices, indices) != header->checksum)
+        return false;
+
+    out.header = header;
+    out.vertices = vertices;
+    out.indices = indices;
+    return true;
+}
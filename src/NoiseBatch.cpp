@@ -0,0 +1,452 @@
+#include "../include/NoiseBatch.h"
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define NOISE_BATCH_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define NOISE_TARGET(isa)
+#else
+#include <cpuid.h>
+#define NOISE_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+/* -------------------------- */
+/* Constants shared with FastNoiseLite::SingleSimplex */
+/* Computed with the same float expressions so every path rounds alike */
+/* -------------------------- */
+static const float SQRT3 = 1.7320508075688772935274463415059f;
+static const float F2 = 0.5f * (SQRT3 - 1);
+static const float G2 = (3 - SQRT3) / 6;
+static const float C_T = (float)(2 * (1 - 2 * G2) * (1 / G2 - 2));
+static const float C_A = (float)(-2 * (1 - 2 * G2) * (1 - 2 * G2));
+static const float G2_2M1 = 2 * (float)G2 - 1;
+static const float G2_M1 = (float)G2 - 1;
+static const float SCALE = 99.83685446303647f;
+
+static const int PRIME_X = 501125321;
+static const int PRIME_Y = 1136930381;
+static const int HASH_MUL = 0x27d4eb2d;
+
+// FastNoiseLite::Lookup<float>::Gradients2D (private there, so mirrored here)
+alignas(64) static const float GRADIENTS_2D[256] =
+{
+    0.130526192220052f, 0.99144486137381f, 0.38268343236509f, 0.923879532511287f, 0.608761429008721f, 0.793353340291235f, 0.793353340291235f, 0.608761429008721f,
+    0.923879532511287f, 0.38268343236509f, 0.99144486137381f, 0.130526192220051f, 0.99144486137381f, -0.130526192220051f, 0.923879532511287f, -0.38268343236509f,
+    0.793353340291235f, -0.60876142900872f, 0.608761429008721f, -0.793353340291235f, 0.38268343236509f, -0.923879532511287f, 0.130526192220052f, -0.99144486137381f,
+    -0.130526192220052f, -0.99144486137381f, -0.38268343236509f, -0.923879532511287f, -0.608761429008721f, -0.793353340291235f, -0.793353340291235f, -0.608761429008721f,
+    -0.923879532511287f, -0.38268343236509f, -0.99144486137381f, -0.130526192220052f, -0.99144486137381f, 0.130526192220051f, -0.923879532511287f, 0.38268343236509f,
+    -0.793353340291235f, 0.608761429008721f, -0.608761429008721f, 0.793353340291235f, -0.38268343236509f, 0.923879532511287f, -0.130526192220052f, 0.99144486137381f,
+    0.130526192220052f, 0.99144486137381f, 0.38268343236509f, 0.923879532511287f, 0.608761429008721f, 0.793353340291235f, 0.793353340291235f, 0.608761429008721f,
+    0.923879532511287f, 0.38268343236509f, 0.99144486137381f, 0.130526192220051f, 0.99144486137381f, -0.130526192220051f, 0.923879532511287f, -0.38268343236509f,
+    0.793353340291235f, -0.60876142900872f, 0.608761429008721f, -0.793353340291235f, 0.38268343236509f, -0.923879532511287f, 0.130526192220052f, -0.99144486137381f,
+    -0.130526192220052f, -0.99144486137381f, -0.38268343236509f, -0.923879532511287f, -0.608761429008721f, -0.793353340291235f, -0.793353340291235f, -0.608761429008721f,
+    -0.923879532511287f, -0.38268343236509f, -0.99144486137381f, -0.130526192220052f, -0.99144486137381f, 0.130526192220051f, -0.923879532511287f, 0.38268343236509f,
+    -0.793353340291235f, 0.608761429008721f, -0.608761429008721f, 0.793353340291235f, -0.38268343236509f, 0.923879532511287f, -0.130526192220052f, 0.99144486137381f,
+    0.130526192220052f, 0.99144486137381f, 0.38268343236509f, 0.923879532511287f, 0.608761429008721f, 0.793353340291235f, 0.793353340291235f, 0.608761429008721f,
+    0.923879532511287f, 0.38268343236509f, 0.99144486137381f, 0.130526192220051f, 0.99144486137381f, -0.130526192220051f, 0.923879532511287f, -0.38268343236509f,
+    0.793353340291235f, -0.60876142900872f, 0.608761429008721f, -0.793353340291235f, 0.38268343236509f, -0.923879532511287f, 0.130526192220052f, -0.99144486137381f,
+    -0.130526192220052f, -0.99144486137381f, -0.38268343236509f, -0.923879532511287f, -0.608761429008721f, -0.793353340291235f, -0.793353340291235f, -0.608761429008721f,
+    -0.923879532511287f, -0.38268343236509f, -0.99144486137381f, -0.130526192220052f, -0.99144486137381f, 0.130526192220051f, -0.923879532511287f, 0.38268343236509f,
+    -0.793353340291235f, 0.608761429008721f, -0.608761429008721f, 0.793353340291235f, -0.38268343236509f, 0.923879532511287f, -0.130526192220052f, 0.99144486137381f,
+    0.130526192220052f, 0.99144486137381f, 0.38268343236509f, 0.923879532511287f, 0.608761429008721f, 0.793353340291235f, 0.793353340291235f, 0.608761429008721f,
+    0.923879532511287f, 0.38268343236509f, 0.99144486137381f, 0.130526192220051f, 0.99144486137381f, -0.130526192220051f, 0.923879532511287f, -0.38268343236509f,
+    0.793353340291235f, -0.60876142900872f, 0.608761429008721f, -0.793353340291235f, 0.38268343236509f, -0.923879532511287f, 0.130526192220052f, -0.99144486137381f,
+    -0.130526192220052f, -0.99144486137381f, -0.38268343236509f, -0.923879532511287f, -0.608761429008721f, -0.793353340291235f, -0.793353340291235f, -0.608761429008721f,
+    -0.923879532511287f, -0.38268343236509f, -0.99144486137381f, -0.130526192220052f, -0.99144486137381f, 0.130526192220051f, -0.923879532511287f, 0.38268343236509f,
+    -0.793353340291235f, 0.608761429008721f, -0.608761429008721f, 0.793353340291235f, -0.38268343236509f, 0.923879532511287f, -0.130526192220052f, 0.99144486137381f,
+    0.130526192220052f, 0.99144486137381f, 0.38268343236509f, 0.923879532511287f, 0.608761429008721f, 0.793353340291235f, 0.793353340291235f, 0.608761429008721f,
+    0.923879532511287f, 0.38268343236509f, 0.99144486137381f, 0.130526192220051f, 0.99144486137381f, -0.130526192220051f, 0.923879532511287f, -0.38268343236509f,
+    0.793353340291235f, -0.60876142900872f, 0.608761429008721f, -0.793353340291235f, 0.38268343236509f, -0.923879532511287f, 0.130526192220052f, -0.99144486137381f,
+    -0.130526192220052f, -0.99144486137381f, -0.38268343236509f, -0.923879532511287f, -0.608761429008721f, -0.793353340291235f, -0.793353340291235f, -0.608761429008721f,
+    -0.923879532511287f, -0.38268343236509f, -0.99144486137381f, -0.130526192220052f, -0.99144486137381f, 0.130526192220051f, -0.923879532511287f, 0.38268343236509f,
+    -0.793353340291235f, 0.608761429008721f, -0.608761429008721f, 0.793353340291235f, -0.38268343236509f, 0.923879532511287f, -0.130526192220052f, 0.99144486137381f,
+    0.38268343236509f, 0.923879532511287f, 0.923879532511287f, 0.38268343236509f, 0.923879532511287f, -0.38268343236509f, 0.38268343236509f, -0.923879532511287f,
+    -0.38268343236509f, -0.923879532511287f, -0.923879532511287f, -0.38268343236509f, -0.923879532511287f, 0.38268343236509f, -0.38268343236509f, 0.923879532511287f,
+};
+
+/* -------------------------- */
+/* Scalar kernel: FastNoiseLite::GetNoise(x, y) for OpenSimplex2 */
+/* -------------------------- */
+static float gradCoord(int seed, int xPrimed, int yPrimed, float xd, float yd)
+{
+    // Unsigned multiply gives the same wrap-around as FastNoiseLite without UB
+    int hash = int(unsigned(seed ^ xPrimed ^ yPrimed) * unsigned(HASH_MUL));
+    hash ^= hash >> 15;
+    hash &= 127 << 1;
+
+    return xd * GRADIENTS_2D[hash] + yd * GRADIENTS_2D[hash | 1];
+}
+
+static float simplex2Scalar(int seed, float frequency, float x, float y)
+{
+    x *= frequency;
+    y *= frequency;
+
+    float s = (x + y) * F2;
+    x += s;
+    y += s;
+
+    int i = x >= 0 ? (int)x : (int)x - 1;
+    int j = y >= 0 ? (int)y : (int)y - 1;
+    float xi = x - i;
+    float yi = y - j;
+
+    float t = (xi + yi) * G2;
+    float x0 = xi - t;
+    float y0 = yi - t;
+
+    i = int(unsigned(i) * unsigned(PRIME_X));
+    j = int(unsigned(j) * unsigned(PRIME_Y));
+    int iX = int(unsigned(i) + unsigned(PRIME_X));
+    int jY = int(unsigned(j) + unsigned(PRIME_Y));
+
+    float n0 = 0, n1 = 0, n2 = 0;
+
+    float a = 0.5f - x0 * x0 - y0 * y0;
+    if (a > 0)
+        n0 = (a * a) * (a * a) * gradCoord(seed, i, j, x0, y0);
+
+    float c = C_T * t + (C_A + a);
+    if (c > 0)
+    {
+        float x2 = x0 + G2_2M1;
+        float y2 = y0 + G2_2M1;
+        n2 = (c * c) * (c * c) * gradCoord(seed, iX, jY, x2, y2);
+    }
+
+    if (y0 > x0)
+    {
+        float x1 = x0 + G2;
+        float y1 = y0 + G2_M1;
+        float b = 0.5f - x1 * x1 - y1 * y1;
+        if (b > 0)
+            n1 = (b * b) * (b * b) * gradCoord(seed, i, jY, x1, y1);
+    }
+    else
+    {
+        float x1 = x0 + G2_M1;
+        float y1 = y0 + G2;
+        float b = 0.5f - x1 * x1 - y1 * y1;
+        if (b > 0)
+            n1 = (b * b) * (b * b) * gradCoord(seed, iX, j, x1, y1);
+    }
+
+    return (n0 + n1 + n2) * SCALE;
+}
+
+static void batchScalar(const Simplex2Params& p, const float* x, const float* y, float* out, int count)
+{
+    for (int k = 0; k < count; ++k)
+        out[k] = simplex2Scalar(p.seed, p.frequency, x[k], y[k]);
+}
+
+#ifdef NOISE_BATCH_X86
+
+/* -------------------------- */
+/* SSE4.1 kernel: 4 points per iteration */
+/* Same operation order as simplex2Scalar, lane by lane */
+/* -------------------------- */
+NOISE_TARGET("sse4.1")
+static __m128 gradCoord4(__m128i seed, __m128i xPrimed, __m128i yPrimed, __m128 xd, __m128 yd)
+{
+    __m128i hash = _mm_xor_si128(seed, _mm_xor_si128(xPrimed, yPrimed));
+    hash = _mm_mullo_epi32(hash, _mm_set1_epi32(HASH_MUL));
+    hash = _mm_xor_si128(hash, _mm_srai_epi32(hash, 15));
+    hash = _mm_and_si128(hash, _mm_set1_epi32(127 << 1));
+
+    alignas(16) int h[4];
+    _mm_store_si128((__m128i*)h, hash);
+    __m128 xg = _mm_setr_ps(GRADIENTS_2D[h[0]], GRADIENTS_2D[h[1]], GRADIENTS_2D[h[2]], GRADIENTS_2D[h[3]]);
+    __m128 yg = _mm_setr_ps(GRADIENTS_2D[h[0] | 1], GRADIENTS_2D[h[1] | 1], GRADIENTS_2D[h[2] | 1], GRADIENTS_2D[h[3] | 1]);
+
+    return _mm_add_ps(_mm_mul_ps(xd, xg), _mm_mul_ps(yd, yg));
+}
+
+NOISE_TARGET("sse4.1")
+static void batchSSE41(const Simplex2Params& p, const float* px, const float* py, float* out, int count)
+{
+    const __m128 freq = _mm_set1_ps(p.frequency);
+    const __m128i seed = _mm_set1_epi32(p.seed);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 g2 = _mm_set1_ps(G2);
+    const __m128 g2m1 = _mm_set1_ps(G2_M1);
+    const __m128i primeX = _mm_set1_epi32(PRIME_X);
+    const __m128i primeY = _mm_set1_epi32(PRIME_Y);
+
+    // The last partial batch runs through the same lanes, padded, so a
+    // point's result does not depend on where it falls in the batch
+    alignas(32) float tailX[4] = {}, tailY[4] = {}, tailOut[4];
+    for (int k = 0; k < count; k += 4)
+    {
+        const float* bx = px + k;
+        const float* by = py + k;
+        float* bo = out + k;
+        const int lanes = std::min(count - k, 4);
+        if (lanes < 4)
+        {
+            std::copy(bx, bx + lanes, tailX);
+            std::copy(by, by + lanes, tailY);
+            bx = tailX;
+            by = tailY;
+            bo = tailOut;
+        }
+
+        __m128 x = _mm_mul_ps(_mm_loadu_ps(bx), freq);
+        __m128 y = _mm_mul_ps(_mm_loadu_ps(by), freq);
+
+        __m128 s = _mm_mul_ps(_mm_add_ps(x, y), _mm_set1_ps(F2));
+        x = _mm_add_ps(x, s);
+        y = _mm_add_ps(y, s);
+
+        // FastFloor: truncate, minus one for negatives (even exact integers)
+        __m128i i = _mm_add_epi32(_mm_cvttps_epi32(x), _mm_castps_si128(_mm_cmplt_ps(x, zero)));
+        __m128i j = _mm_add_epi32(_mm_cvttps_epi32(y), _mm_castps_si128(_mm_cmplt_ps(y, zero)));
+        __m128 xi = _mm_sub_ps(x, _mm_cvtepi32_ps(i));
+        __m128 yi = _mm_sub_ps(y, _mm_cvtepi32_ps(j));
+
+        __m128 t = _mm_mul_ps(_mm_add_ps(xi, yi), g2);
+        __m128 x0 = _mm_sub_ps(xi, t);
+        __m128 y0 = _mm_sub_ps(yi, t);
+
+        i = _mm_mullo_epi32(i, primeX);
+        j = _mm_mullo_epi32(j, primeY);
+        __m128i iX = _mm_add_epi32(i, primeX);
+        __m128i jY = _mm_add_epi32(j, primeY);
+
+        // Corner 0
+        __m128 a = _mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(x0, x0)), _mm_mul_ps(y0, y0));
+        __m128 a2 = _mm_mul_ps(a, a);
+        __m128 n0 = _mm_mul_ps(_mm_mul_ps(a2, a2), gradCoord4(seed, i, j, x0, y0));
+        n0 = _mm_and_ps(n0, _mm_cmpgt_ps(a, zero));
+
+        // Corner 2
+        __m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(C_T), t), _mm_add_ps(_mm_set1_ps(C_A), a));
+        __m128 x2 = _mm_add_ps(x0, _mm_set1_ps(G2_2M1));
+        __m128 y2 = _mm_add_ps(y0, _mm_set1_ps(G2_2M1));
+        __m128 c2 = _mm_mul_ps(c, c);
+        __m128 n2 = _mm_mul_ps(_mm_mul_ps(c2, c2), gradCoord4(seed, iX, jY, x2, y2));
+        n2 = _mm_and_ps(n2, _mm_cmpgt_ps(c, zero));
+
+        // Corner 1: upper or lower triangle
+        __m128 upper = _mm_cmpgt_ps(y0, x0);
+        __m128 x1 = _mm_add_ps(x0, _mm_blendv_ps(g2m1, g2, upper));
+        __m128 y1 = _mm_add_ps(y0, _mm_blendv_ps(g2, g2m1, upper));
+        __m128i i1 = _mm_blendv_epi8(iX, i, _mm_castps_si128(upper));
+        __m128i j1 = _mm_blendv_epi8(j, jY, _mm_castps_si128(upper));
+        __m128 b = _mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(x1, x1)), _mm_mul_ps(y1, y1));
+        __m128 b2 = _mm_mul_ps(b, b);
+        __m128 n1 = _mm_mul_ps(_mm_mul_ps(b2, b2), gradCoord4(seed, i1, j1, x1, y1));
+        n1 = _mm_and_ps(n1, _mm_cmpgt_ps(b, zero));
+
+        __m128 sum = _mm_add_ps(_mm_add_ps(n0, n1), n2);
+        _mm_storeu_ps(bo, _mm_mul_ps(sum, _mm_set1_ps(SCALE)));
+        if (bo == tailOut)
+            std::copy(tailOut, tailOut + lanes, out + k);
+    }
+}
+
+/* -------------------------- */
+/* AVX2 kernel: 8 points per iteration with gathered gradients */
+/* -------------------------- */
+NOISE_TARGET("avx2")
+static __m256 gradCoord8(__m256i seed, __m256i xPrimed, __m256i yPrimed, __m256 xd, __m256 yd)
+{
+    __m256i hash = _mm256_xor_si256(seed, _mm256_xor_si256(xPrimed, yPrimed));
+    hash = _mm256_mullo_epi32(hash, _mm256_set1_epi32(HASH_MUL));
+    hash = _mm256_xor_si256(hash, _mm256_srai_epi32(hash, 15));
+    hash = _mm256_and_si256(hash, _mm256_set1_epi32(127 << 1));
+
+    __m256 xg = _mm256_i32gather_ps(GRADIENTS_2D, hash, 4);
+    __m256 yg = _mm256_i32gather_ps(GRADIENTS_2D, _mm256_or_si256(hash, _mm256_set1_epi32(1)), 4);
+
+    return _mm256_add_ps(_mm256_mul_ps(xd, xg), _mm256_mul_ps(yd, yg));
+}
+
+NOISE_TARGET("avx2")
+static void batchAVX2(const Simplex2Params& p, const float* px, const float* py, float* out, int count)
+{
+    const __m256 freq = _mm256_set1_ps(p.frequency);
+    const __m256i seed = _mm256_set1_epi32(p.seed);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 g2 = _mm256_set1_ps(G2);
+    const __m256 g2m1 = _mm256_set1_ps(G2_M1);
+    const __m256i primeX = _mm256_set1_epi32(PRIME_X);
+    const __m256i primeY = _mm256_set1_epi32(PRIME_Y);
+
+    // The last partial batch runs through the same lanes, padded, so a
+    // point's result does not depend on where it falls in the batch
+    alignas(32) float tailX[8] = {}, tailY[8] = {}, tailOut[8];
+    for (int k = 0; k < count; k += 8)
+    {
+        const float* bx = px + k;
+        const float* by = py + k;
+        float* bo = out + k;
+        const int lanes = std::min(count - k, 8);
+        if (lanes < 8)
+        {
+            std::copy(bx, bx + lanes, tailX);
+            std::copy(by, by + lanes, tailY);
+            bx = tailX;
+            by = tailY;
+            bo = tailOut;
+        }
+
+        __m256 x = _mm256_mul_ps(_mm256_loadu_ps(bx), freq);
+        __m256 y = _mm256_mul_ps(_mm256_loadu_ps(by), freq);
+
+        __m256 s = _mm256_mul_ps(_mm256_add_ps(x, y), _mm256_set1_ps(F2));
+        x = _mm256_add_ps(x, s);
+        y = _mm256_add_ps(y, s);
+
+        // FastFloor: truncate, minus one for negatives (even exact integers)
+        __m256i i = _mm256_add_epi32(_mm256_cvttps_epi32(x), _mm256_castps_si256(_mm256_cmp_ps(x, zero, _CMP_LT_OQ)));
+        __m256i j = _mm256_add_epi32(_mm256_cvttps_epi32(y), _mm256_castps_si256(_mm256_cmp_ps(y, zero, _CMP_LT_OQ)));
+        __m256 xi = _mm256_sub_ps(x, _mm256_cvtepi32_ps(i));
+        __m256 yi = _mm256_sub_ps(y, _mm256_cvtepi32_ps(j));
+
+        __m256 t = _mm256_mul_ps(_mm256_add_ps(xi, yi), g2);
+        __m256 x0 = _mm256_sub_ps(xi, t);
+        __m256 y0 = _mm256_sub_ps(yi, t);
+
+        i = _mm256_mullo_epi32(i, primeX);
+        j = _mm256_mullo_epi32(j, primeY);
+        __m256i iX = _mm256_add_epi32(i, primeX);
+        __m256i jY = _mm256_add_epi32(j, primeY);
+
+        // Corner 0
+        __m256 a = _mm256_sub_ps(_mm256_sub_ps(half, _mm256_mul_ps(x0, x0)), _mm256_mul_ps(y0, y0));
+        __m256 a2 = _mm256_mul_ps(a, a);
+        __m256 n0 = _mm256_mul_ps(_mm256_mul_ps(a2, a2), gradCoord8(seed, i, j, x0, y0));
+        n0 = _mm256_and_ps(n0, _mm256_cmp_ps(a, zero, _CMP_GT_OQ));
+
+        // Corner 2
+        __m256 c = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(C_T), t), _mm256_add_ps(_mm256_set1_ps(C_A), a));
+        __m256 x2 = _mm256_add_ps(x0, _mm256_set1_ps(G2_2M1));
+        __m256 y2 = _mm256_add_ps(y0, _mm256_set1_ps(G2_2M1));
+        __m256 c2 = _mm256_mul_ps(c, c);
+        __m256 n2 = _mm256_mul_ps(_mm256_mul_ps(c2, c2), gradCoord8(seed, iX, jY, x2, y2));
+        n2 = _mm256_and_ps(n2, _mm256_cmp_ps(c, zero, _CMP_GT_OQ));
+
+        // Corner 1: upper or lower triangle
+        __m256 upper = _mm256_cmp_ps(y0, x0, _CMP_GT_OQ);
+        __m256 x1 = _mm256_add_ps(x0, _mm256_blendv_ps(g2m1, g2, upper));
+        __m256 y1 = _mm256_add_ps(y0, _mm256_blendv_ps(g2, g2m1, upper));
+        __m256i i1 = _mm256_blendv_epi8(iX, i, _mm256_castps_si256(upper));
+        __m256i j1 = _mm256_blendv_epi8(j, jY, _mm256_castps_si256(upper));
+        __m256 b = _mm256_sub_ps(_mm256_sub_ps(half, _mm256_mul_ps(x1, x1)), _mm256_mul_ps(y1, y1));
+        __m256 b2 = _mm256_mul_ps(b, b);
+        __m256 n1 = _mm256_mul_ps(_mm256_mul_ps(b2, b2), gradCoord8(seed, i1, j1, x1, y1));
+        n1 = _mm256_and_ps(n1, _mm256_cmp_ps(b, zero, _CMP_GT_OQ));
+
+        __m256 sum = _mm256_add_ps(_mm256_add_ps(n0, n1), n2);
+        _mm256_storeu_ps(bo, _mm256_mul_ps(sum, _mm256_set1_ps(SCALE)));
+        if (bo == tailOut)
+            std::copy(tailOut, tailOut + lanes, out + k);
+    }
+}
+
+/* -------------------------- */
+/* CPU feature detection */
+/* -------------------------- */
+static void cpuid(int leaf, int sub, int regs[4])
+{
+#if defined(_MSC_VER)
+    __cpuidex(regs, leaf, sub);
+#else
+    unsigned a, b, c, d;
+    __cpuid_count(leaf, sub, a, b, c, d);
+    regs[0] = int(a); regs[1] = int(b); regs[2] = int(c); regs[3] = int(d);
+#endif
+}
+
+static SimdLevel queryCpu()
+{
+    int regs[4];
+    cpuid(0, 0, regs);
+    int maxLeaf = regs[0];
+
+    cpuid(1, 0, regs);
+    bool sse41 = (regs[2] & (1 << 19)) != 0;
+    bool osxsave = (regs[2] & (1 << 27)) != 0;
+    bool avx = (regs[2] & (1 << 28)) != 0;
+
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osxsave && avx)
+    {
+        // The OS must save YMM state for AVX2 to be usable
+#if defined(_MSC_VER)
+        unsigned long long xcr0 = _xgetbv(0);
+#else
+        unsigned eax, edx;
+        __asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        unsigned long long xcr0 = (unsigned long long)edx << 32 | eax;
+#endif
+        cpuid(7, 0, regs);
+        avx2 = (xcr0 & 6) == 6 && (regs[1] & (1 << 5)) != 0;
+    }
+
+    if (avx2) return SimdLevel::AVX2;
+    if (sse41) return SimdLevel::SSE41;
+    return SimdLevel::Scalar;
+}
+
+#else
+
+static SimdLevel queryCpu()
+{
+    return SimdLevel::Scalar;
+}
+
+#endif
+
+/* -------------------------- */
+/* Public entry points */
+/* -------------------------- */
+SimdLevel detectSimdLevel()
+{
+    static const SimdLevel level = queryCpu();
+    return level;
+}
+
+const char* simdLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::AVX2: return "AVX2";
+    case SimdLevel::SSE41: return "SSE4.1";
+    default: return "Scalar";
+    }
+}
+
+void simplex2BatchLevel(SimdLevel level, const Simplex2Params& params,
+    const float* x, const float* y, float* out, int count)
+{
+    switch (level)
+    {
+#ifdef NOISE_BATCH_X86
+    case SimdLevel::AVX2: batchAVX2(params, x, y, out, count); break;
+    case SimdLevel::SSE41: batchSSE41(params, x, y, out, count); break;
+#endif
+    default: batchScalar(params, x, y, out, count); break;
+    }
+}
+
+void simplex2Batch(const Simplex2Params& params,
+    const float* x, const float* y, float* out, int count)
+{
+    simplex2BatchLevel(detectSimdLevel(), params, x, y, out, count);
+}
+
+int noiseArithmetic()
+{
+#if defined(__FMA__)
+    return 1 + int(detectSimdLevel());
+#else
+    return 0;
+#endif
+}
@@ -1,21 +1,49 @@
 #include "../include/OceanBiome.h"
 #include "../include/Chunk.h"
 
-OceanBiome::OceanBiome(float scale, float water)
+// Floor noise settings at voxelScale 1, shared with hashParams
+static constexpr float FLOOR_FREQUENCY = 0.00005f;
+static constexpr int FLOOR_OCTAVES = 3;
+
+OceanBiome::OceanBiome(float scale, float water, int seed)
     : waterLevel(water)
 {
+    floorNoise.SetSeed(seed);
     floorNoise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
-    floorNoise.SetFrequency(0.00005f / scale);
-    floorNoise.SetFractalOctaves(3);
+    floorNoise.SetFrequency(FLOOR_FREQUENCY / scale);
+    floorNoise.SetFractalOctaves(FLOOR_OCTAVES);
+    floorParams.frequency = FLOOR_FREQUENCY / scale;
+    floorParams.seed = seed;
 }
 
-float OceanBiome::getHeight(float wx, float wz) const
+float OceanBiome::heightFromNoise(float floor) const
 {
     float base = waterLevel - 15.0f * VOXEL_SIZE;          // deep
-    float var = 1.0f * VOXEL_SIZE * floorNoise.GetNoise(wx, wz);
+    float var = 1.0f * VOXEL_SIZE * floor;
     return base + var;
 }
 
+float OceanBiome::getHeight(float wx, float wz) const
+{
+    return heightFromNoise(floorNoise.GetNoise(wx, wz));
+}
+
+void OceanBiome::getHeights(const float* wx, const float* wz, float* out, int count) const
+{
+    simplex2Batch(floorParams, wx, wz, out, count);
+    for (int i = 0; i < count; ++i)
+        out[i] = heightFromNoise(out[i]);
+}
+
+void OceanBiome::hashParams(std::uint64_t& h) const
+{
+    const int octaves = FLOOR_OCTAVES;
+    hashBytes(h, &floorParams.seed, sizeof(floorParams.seed));
+    hashBytes(h, &floorParams.frequency, sizeof(floorParams.frequency));   // Already divided by voxelScale
+    hashBytes(h, &octaves, sizeof(octaves));
+    hashBytes(h, &waterLevel, sizeof(waterLevel));
+}
+
 glm::vec3 OceanBiome::getSurfaceColor(float) const
 {
     return { 0.10f, 0.35f, 0.55f };  // dark sand / mud
@@ -1,19 +1,34 @@
 ﻿#include "../include/PlainsBiome.h"
 #include "../include/Chunk.h"        // BASE_HEIGHT_WORLD, etc.
+#include <vector>
 
-PlainsBiome::PlainsBiome(float scale, float water)
+// Noise layer settings at voxelScale 1, shared with hashParams
+struct NoiseLayer
+{
+    float frequency;
+    int octaves;
+};
+static constexpr NoiseLayer CONTINENTAL_LAYER = { 0.0001f, 4 };
+static constexpr NoiseLayer HILLS_LAYER = { 0.0010f, 3 };
+static constexpr NoiseLayer DETAIL_LAYER = { 0.0060f, 2 };
+static constexpr float FRACTAL_GAIN = 0.5f;
+
+PlainsBiome::PlainsBiome(float scale, float water, int seed)
     : waterLevel(water)
 {
-    auto cfg = [&](FastNoiseLite& n, float freq, int oct)
+    auto cfg = [&](FastNoiseLite& n, Simplex2Params& p, const NoiseLayer& layer)
         {
+            n.SetSeed(seed);
             n.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
-            n.SetFrequency(freq / scale);
-            n.SetFractalOctaves(oct);
-            n.SetFractalGain(0.5f);
+            n.SetFrequency(layer.frequency / scale);
+            n.SetFractalOctaves(layer.octaves);
+            n.SetFractalGain(FRACTAL_GAIN);
+            p.frequency = layer.frequency / scale;
+            p.seed = seed;
         };
-    cfg(continental, 0.0001f, 4);
-    cfg(hills, 0.0010f, 3);
-    cfg(detail, 0.0060f, 2);
+    cfg(continental, continentalParams, CONTINENTAL_LAYER);
+    cfg(hills, hillsParams, HILLS_LAYER);
+    cfg(detail, detailParams, DETAIL_LAYER);
 }
 
 static float hillStrength(float aboveWater)
@@ -21,11 +36,11 @@ static float hillStrength(float aboveWater)
     return glm::clamp((aboveWater - 32.0f) / 8.0f, 0.f, 1.f);
 }
 
-float PlainsBiome::getHeight(float wx, float wz) const
+float PlainsBiome::heightFromNoise(float continentalN, float detailN, float hillNoise) const
 {
     // --- 1. Continental & detail drive base terrain -----------
-    float baseNoise = continental.GetNoise(wx, wz) * 0.85f
-        + detail.GetNoise(wx, wz) * 0.15f;
+    float baseNoise = continentalN * 0.85f
+        + detailN * 0.15f;
 
     float baseShape = 0.5f * (baseNoise + 1.f);  // [0, 1]
 
@@ -33,7 +48,6 @@ float PlainsBiome::getHeight(float wx, float wz) const
         + HEIGHT_VARIATION_WORLD * 0.4f * baseShape;  // base shape
 
     // --- 2. Hills are added separately ------------------------
-    float hillNoise = hills.GetNoise(wx, wz);  // [-1, 1]
     float hillHeight = HEIGHT_VARIATION_WORLD * 0.5f * hillNoise;
 
     float above = h - waterLevel;
@@ -44,6 +58,40 @@ float PlainsBiome::getHeight(float wx, float wz) const
     return h;
 }
 
+float PlainsBiome::getHeight(float wx, float wz) const
+{
+    return heightFromNoise(continental.GetNoise(wx, wz),
+        detail.GetNoise(wx, wz),
+        hills.GetNoise(wx, wz));  // [-1, 1]
+}
+
+void PlainsBiome::getHeights(const float* wx, const float* wz, float* out, int count) const
+{
+    std::vector<float> continentalN(count), detailN(count);
+
+    simplex2Batch(continentalParams, wx, wz, continentalN.data(), count);
+    simplex2Batch(detailParams, wx, wz, detailN.data(), count);
+    simplex2Batch(hillsParams, wx, wz, out, count);
+
+    for (int i = 0; i < count; ++i)
+        out[i] = heightFromNoise(continentalN[i], detailN[i], out[i]);
+}
+
+
+void PlainsBiome::hashParams(std::uint64_t& h) const
+{
+    const Simplex2Params* params[] = { &continentalParams, &hillsParams, &detailParams };
+    const NoiseLayer layers[] = { CONTINENTAL_LAYER, HILLS_LAYER, DETAIL_LAYER };
+    for (int i = 0; i < 3; ++i)
+    {
+        hashBytes(h, &params[i]->seed, sizeof(int));
+        hashBytes(h, &params[i]->frequency, sizeof(float));   // Already divided by voxelScale
+        hashBytes(h, &layers[i].octaves, sizeof(int));
+    }
+    const float gain = FRACTAL_GAIN;
+    hashBytes(h, &gain, sizeof(gain));
+    hashBytes(h, &waterLevel, sizeof(waterLevel));
+}
 
 glm::vec3 PlainsBiome::getSurfaceColor(float) const
 {
@@ -0,0 +1,132 @@
+#include "../include/RecordingArenaBackend.h"
+
+unsigned RecordingArenaBackend::createBuffer(BufferKind, std::size_t bytes)
+{
+    buffers[nextId] = bytes;
+    liveBytes += bytes;
+    totals.buffersCreated++;
+    totals.bufferBytesCreated += bytes;
+    return nextId++;
+}
+
+void RecordingArenaBackend::destroyBuffer(unsigned buffer)
+{
+    auto it = buffers.find(buffer);
+    if (it == buffers.end())
+    {
+        totals.errors++;
+        return;
+    }
+    liveBytes -= it->second;
+    buffers.erase(it);
+}
+
+std::size_t RecordingArenaBackend::bufferSize(unsigned buffer)
+{
+    auto it = buffers.find(buffer);
+    if (it == buffers.end())
+    {
+        totals.errors++;
+        return 0;
+    }
+    return it->second;
+}
+
+void RecordingArenaBackend::uploadBuffer(unsigned buffer, std::size_t offset, const void*, std::size_t bytes)
+{
+    if (offset + bytes > bufferSize(buffer))
+        totals.errors++;
+    totals.uploads++;
+    totals.bytesUploaded += bytes;
+}
+
+void RecordingArenaBackend::copyBuffer(unsigned src, std::size_t srcOffset, unsigned dst, std::size_t dstOffset, std::size_t bytes)
+{
+    if (srcOffset + bytes > bufferSize(src) || dstOffset + bytes > bufferSize(dst))
+        totals.errors++;
+    totals.copies++;
+    totals.bytesCopied += bytes;
+}
+
+unsigned RecordingArenaBackend::createVertexArray(unsigned vertexBuffer, unsigned indexBuffer)
+{
+    vertexArrays[nextId] = { vertexBuffer, indexBuffer };
+    return nextId++;
+}
+
+void RecordingArenaBackend::destroyVertexArray(unsigned vertexArray)
+{
+    if (vertexArrays.erase(vertexArray) == 0)
+        totals.errors++;
+    if (boundVertexArray == vertexArray)
+        boundVertexArray = 0;
+}
+
+unsigned RecordingArenaBackend::createBufferTexture(unsigned buffer)
+{
+    textures[nextId] = buffer;
+    return nextId++;
+}
+
+void RecordingArenaBackend::destroyTexture(unsigned texture)
+{
+    if (textures.erase(texture) == 0)
+        totals.errors++;
+    if (boundTexture == texture)
+        boundTexture = 0;
+}
+
+void RecordingArenaBackend::bindBufferTexture(unsigned texture)
+{
+    if (texture == boundTexture)
+    {
+        totals.redundantBinds++;
+        return;
+    }
+    boundTexture = texture;
+    totals.stateChanges++;
+}
+
+void RecordingArenaBackend::bindVertexArray(unsigned vertexArray)
+{
+    if (vertexArray == boundVertexArray)
+    {
+        totals.redundantBinds++;
+        return;
+    }
+    boundVertexArray = vertexArray;
+    totals.stateChanges++;
+}
+
+/* ------------------------- */
+/* A draw must come with a vertex array bound, stay inside its index */
+/* buffer and start inside its vertex buffer; anything else is an error */
+/* ------------------------- */
+void RecordingArenaBackend::checkDraw(unsigned indexCount, std::size_t firstIndex, int baseVertex)
+{
+    totals.rangesDrawn++;
+    totals.trianglesDrawn += indexCount / 3;
+
+    auto vao = vertexArrays.find(boundVertexArray);
+    if (vao == vertexArrays.end())
+    {
+        totals.errors++;
+        return;
+    }
+    if ((firstIndex + indexCount) * sizeof(unsigned int) > bufferSize(vao->second.indexBuffer) ||
+        baseVertex < 0 || std::size_t(baseVertex) * sizeof(PackedVertex) >= bufferSize(vao->second.vertexBuffer))
+        totals.errors++;
+}
+
+void RecordingArenaBackend::drawElementsBaseVertex(unsigned indexCount, std::size_t firstIndex, int baseVertex)
+{
+    checkDraw(indexCount, firstIndex, baseVertex);
+    totals.drawCalls++;
+}
+
+void RecordingArenaBackend::multiDraw(const DrawCommandList& list)
+{
+    for (const DrawElementsIndirectCommand& c : list.commands())
+        checkDraw(c.count, c.firstIndex, c.baseVertex);
+    totals.drawCalls++;
+}
@@ -0,0 +1,454 @@
+// Platform headers first: windows.h defines APIENTRY unconditionally,
+// glad (pulled in through Chunk.h) only when it is not yet defined
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <direct.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "../include/RegionCache.h"
+#include "../include/MeshBlob.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#define REGION_FORMAT_VERSION 2    // Bump when the file layout or the meshing output changes
+#define REGION_MAX_OPEN 16         // Region files kept open; a camera touches at most four
+#define REGION_RECORD_ALIGNMENT 64 // Records start on cache lines
+
+/* ------------------------- */
+/* File layout */
+/* [RegionHeader][RegionIndexEntry x REGION_SLOTS] then records at */
+/* REGION_DATA_OFFSET, each one a MeshBlob. Integers are native-endian: */
+/* the cache is local to one machine, and the key changes with the */
+/* build's mesh layout */
+/* ------------------------- */
+namespace
+{
+    const char REGION_MAGIC[8] = { 'T', 'R', 'R', 'E', 'G', 'I', 'O', 'N' };
+    const int REGION_SLOTS = REGION_SIZE * REGION_SIZE * LOD_LEVELS;
+
+    struct RegionHeader
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t slotCount;
+        std::uint64_t key;            // Generator and mesh layout
+        std::int32_t regionX, regionZ;
+    };
+
+    // Where a chunk's blob is; offset 0 means not cached
+    struct RegionIndexEntry
+    {
+        std::uint64_t offset;
+        std::uint64_t bytes;
+    };
+
+    std::uint64_t alignUp(std::uint64_t v, std::uint64_t alignment)
+    {
+        return (v + alignment - 1) / alignment * alignment;
+    }
+
+    const std::uint64_t REGION_INDEX_OFFSET = sizeof(RegionHeader);
+    const std::uint64_t REGION_DATA_OFFSET =
+        alignUp(REGION_INDEX_OFFSET + REGION_SLOTS * sizeof(RegionIndexEntry), REGION_RECORD_ALIGNMENT);
+
+    static_assert(sizeof(RegionHeader) == 32 && sizeof(RegionIndexEntry) == 16, "Region header layout changed");
+}
+
+/* ------------------------- */
+/* RegionMapping: a read-only view of a whole region file */
+/* ------------------------- */
+struct RegionMapping
+{
+    const char* base = nullptr;
+    std::size_t size = 0;
+#if defined(_WIN32)
+    HANDLE mappingHandle = nullptr;
+#endif
+
+    ~RegionMapping()
+    {
+#if defined(_WIN32)
+        if (base)
+            UnmapViewOfFile(base);
+        if (mappingHandle)
+            CloseHandle(mappingHandle);
+#else
+        if (base)
+            munmap(const_cast<char*>(base), size);
+#endif
+    }
+};
+
+/* ------------------------- */
+/* RegionFile: one open region, its index and the latest mapping */
+/* Writes are positional, so readers of older mappings are unaffected */
+/* ------------------------- */
+class RegionFile
+{
+public:
+    ~RegionFile()
+    {
+#if defined(_WIN32)
+        if (handle != INVALID_HANDLE_VALUE)
+            CloseHandle(handle);
+#else
+        if (fd >= 0)
+            close(fd);
+#endif
+    }
+
+    bool open(const std::string& path)
+    {
+#if defined(_WIN32)
+        handle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+            nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        return handle != INVALID_HANDLE_VALUE;
+#else
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        return fd >= 0;
+#endif
+    }
+
+    std::uint64_t size() const
+    {
+#if defined(_WIN32)
+        LARGE_INTEGER s;
+        return GetFileSizeEx(handle, &s) ? std::uint64_t(s.QuadPart) : 0;
+#else
+        struct stat st;
+        return fstat(fd, &st) == 0 ? std::uint64_t(st.st_size) : 0;
+#endif
+    }
+
+    // Sets the length; growing fills with zeros. Only while nothing is mapped
+    bool resize(std::uint64_t bytes)
+    {
+#if defined(_WIN32)
+        LARGE_INTEGER at;
+        at.QuadPart = LONGLONG(bytes);
+        return SetFilePointerEx(handle, at, nullptr, FILE_BEGIN) && SetEndOfFile(handle);
+#else
+        return ftruncate(fd, off_t(bytes)) == 0;
+#endif
+    }
+
+    bool write(std::uint64_t offset, const void* data, std::size_t bytes)
+    {
+        const char* p = static_cast<const char*>(data);
+        while (bytes > 0)
+        {
+#if defined(_WIN32)
+            OVERLAPPED at = {};
+            at.Offset = DWORD(offset);
+            at.OffsetHigh = DWORD(offset >> 32);
+            DWORD chunk = DWORD(std::min<std::size_t>(bytes, 1u << 30)), written = 0;
+            if (!WriteFile(handle, p, chunk, &written, &at) || written == 0)
+                return false;
+#else
+            ssize_t written = pwrite(fd, p, bytes, off_t(offset));
+            if (written <= 0)
+                return false;
+#endif
+            p += written;
+            offset += std::uint64_t(written);
+            bytes -= std::size_t(written);
+        }
+        return true;
+    }
+
+    // Maps the file as it is now; null on failure
+    std::shared_ptr<const RegionMapping> map() const
+    {
+        std::shared_ptr<RegionMapping> m = std::make_shared<RegionMapping>();
+        m->size = std::size_t(size());
+        if (m->size == 0)
+            return nullptr;
+#if defined(_WIN32)
+        m->mappingHandle = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m->mappingHandle)
+            return nullptr;
+        m->base = static_cast<const char*>(MapViewOfFile(m->mappingHandle, FILE_MAP_READ, 0, 0, 0));
+#else
+        void* p = mmap(nullptr, m->size, PROT_READ, MAP_SHARED, fd, 0);
+        m->base = p == MAP_FAILED ? nullptr : static_cast<const char*>(p);
+#endif
+        return m->base ? m : nullptr;
+    }
+
+    std::mutex mutex;                           // Guards everything below
+    std::vector<RegionIndexEntry> index;        // In-memory copy of the file's index
+    std::uint64_t end = REGION_DATA_OFFSET;     // Where the next record goes
+    std::shared_ptr<const RegionMapping> mapping;   // Covers every record in index, or null
+
+private:
+#if defined(_WIN32)
+    HANDLE handle = INVALID_HANDLE_VALUE;
+#else
+    int fd = -1;
+#endif
+};
+
+static void makeDirectory(const std::string& path)
+{
+#if defined(_WIN32)
+    _mkdir(path.c_str());
+#else
+    mkdir(path.c_str(), 0755);
+#endif
+}
+
+/* ------------------------- */
+/* CachedMesh accessors: the blob was validated when it was loaded */
+/* ------------------------- */
+const Chunk::MeshInfo& CachedMesh::info() const
+{
+    return blob.header->info;
+}
+
+const PackedVertex* CachedMesh::vertices() const
+{
+    return blob.vertices;
+}
+
+const unsigned int* CachedMesh::indices() const
+{
+    return blob.indices;
+}
+
+std::size_t CachedMesh::vertexCount() const
+{
+    return blob.vertexCount();
+}
+
+std::size_t CachedMesh::indexCount() const
+{
+    return blob.indexCount();
+}
+
+std::size_t CachedMesh::bytes() const
+{
+    return blob.payloadBytes();
+}
+
+/* ------------------------- */
+/* RegionCache Constructor */
+/* Folds the mesh layout into the generator key: a build that meshes */
+/* or packs differently must not read this one's records */
+/* ------------------------- */
+RegionCache::RegionCache(const std::string& directory, std::uint64_t generatorKey)
+    : directory(directory), key(generatorKey)
+{
+    const std::uint64_t layout[] = { REGION_FORMAT_VERSION, CHUNK_SIZE, CHUNK_HEIGHT, VOXEL_SIZE,
+        POSITION_STEPS_PER_UNIT, LOD_LEVELS, REGION_SIZE, sizeof(PackedVertex), MESH_BLOB_VERSION };
+    for (std::uint64_t v : layout)
+        key = (key ^ v) * 0x100000001B3ull;
+
+    makeDirectory(directory);
+}
+
+RegionCache::~RegionCache() = default;
+
+std::string RegionCache::regionPath(const std::string& directory, glm::ivec2 region)
+{
+    return directory + "/r." + std::to_string(region.x) + "." + std::to_string(region.y) + ".region";
+}
+
+glm::ivec2 RegionCache::regionOf(glm::ivec2 pos)
+{
+    auto floorDiv = [](int v) { return (v >= 0 ? v : v - (REGION_SIZE - 1)) / REGION_SIZE; };
+    return glm::ivec2(floorDiv(pos.x), floorDiv(pos.y));
+}
+
+int RegionCache::slotOf(glm::ivec2 pos, int lod)
+{
+    glm::ivec2 local = pos - regionOf(pos) * REGION_SIZE;
+    return (lod * REGION_SIZE + local.x) * REGION_SIZE + local.y;
+}
+
+std::shared_ptr<RegionFile> RegionCache::region(glm::ivec2 coord)
+{
+    std::lock_guard<std::mutex> lock(regionMutex);
+    auto it = regions.find(coord);
+    if (it != regions.end())
+    {
+        it->second.lastUse = ++useClock;
+        return it->second.file;
+    }
+
+    // Close the least recently used region nobody is reading or writing
+    // (references are only taken under regionMutex, so the count is exact)
+    if (regions.size() >= REGION_MAX_OPEN)
+    {
+        auto oldest = regions.end();
+        for (auto r = regions.begin(); r != regions.end(); ++r)
+            if (r->second.file.use_count() <= 1 && (oldest == regions.end() || r->second.lastUse < oldest->second.lastUse))
+                oldest = r;
+        if (oldest != regions.end())
+            regions.erase(oldest);
+    }
+
+    // Failures are remembered too, so a bad file is reported once
+    std::shared_ptr<RegionFile> file = openRegion(coord);
+    regions[coord] = { file, ++useClock };
+    return file;
+}
+
+/* ------------------------- */
+/* Open a region file, adopting its index if the header matches */
+/* ------------------------- */
+std::shared_ptr<RegionFile> RegionCache::openRegion(glm::ivec2 coord)
+{
+    std::string path = regionPath(directory, coord);
+    std::shared_ptr<RegionFile> file = std::make_shared<RegionFile>();
+    if (!file->open(path))
+    {
+        std::cerr << "RegionCache: cannot open " << path << std::endl;
+        return nullptr;
+    }
+
+    file->index.assign(REGION_SLOTS, RegionIndexEntry{ 0, 0 });
+    std::uint64_t size = file->size();
+
+    if (size >= REGION_DATA_OFFSET)
+    {
+        file->mapping = file->map();
+        if (file->mapping)
+        {
+            RegionHeader header;
+            std::memcpy(&header, file->mapping->base, sizeof(header));
+            bool current = std::memcmp(header.magic, REGION_MAGIC, sizeof(REGION_MAGIC)) == 0
+                && header.version == REGION_FORMAT_VERSION && header.slotCount == std::uint32_t(REGION_SLOTS)
+                && header.key == key && header.regionX == coord.x && header.regionZ == coord.y;
+
+            if (current)
+            {
+                // Entries past the end are from a torn write; drop them
+                std::memcpy(file->index.data(), file->mapping->base + REGION_INDEX_OFFSET,
+                    REGION_SLOTS * sizeof(RegionIndexEntry));
+                for (RegionIndexEntry& entry : file->index)
+                    if (entry.offset < REGION_DATA_OFFSET || entry.offset + entry.bytes > size)
+                        entry = RegionIndexEntry{ 0, 0 };
+
+                file->end = alignUp(size, REGION_RECORD_ALIGNMENT);
+                return file;
+            }
+            file->mapping.reset();
+        }
+    }
+
+    // Missing, damaged or made by another generator: start over
+    if (size > 0)
+        staleCount.fetch_add(1, std::memory_order_relaxed);
+
+    RegionHeader header = {};
+    std::memcpy(header.magic, REGION_MAGIC, sizeof(REGION_MAGIC));
+    header.version = REGION_FORMAT_VERSION;
+    header.slotCount = REGION_SLOTS;
+    header.key = key;
+    header.regionX = coord.x;
+    header.regionZ = coord.y;
+
+    if (!file->resize(0) || !file->resize(REGION_DATA_OFFSET) || !file->write(0, &header, sizeof(header)))
+    {
+        std::cerr << "RegionCache: cannot initialise " << path << std::endl;
+        return nullptr;
+    }
+    file->end = REGION_DATA_OFFSET;
+    return file;
+}
+
+/* ------------------------- */
+/* Look up a chunk; the view points straight into the mapped file */
+/* The blob is validated outside the region lock, so other workers keep */
+/* reading and writing the region meanwhile */
+/* ------------------------- */
+bool RegionCache::load(glm::ivec2 pos, int lod, CachedMesh& out)
+{
+    std::shared_ptr<RegionFile> file = region(regionOf(pos));
+    std::shared_ptr<const RegionMapping> mapping;
+    RegionIndexEntry entry = { 0, 0 };
+    if (file)
+    {
+        std::lock_guard<std::mutex> lock(file->mutex);
+        entry = file->index[slotOf(pos, lod)];
+        if (entry.offset != 0)
+        {
+            // Records appended since the last mapping need a fresh one
+            if (!file->mapping || entry.offset + entry.bytes > file->mapping->size)
+                file->mapping = file->map();
+            mapping = file->mapping;
+        }
+    }
+
+    if (mapping)
+    {
+        MeshBlobView blob;
+        if (readMeshBlob(mapping->base + entry.offset, std::size_t(entry.bytes), blob))
+        {
+            out.mapping = mapping;
+            out.blob = blob;
+            hitCount.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        // Left in place: the next store of this chunk replaces the entry
+        corruptCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    missCount.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+/* ------------------------- */
+/* Append a blob, then point the index at it */
+/* A crash between the two leaves the old entry (or none), never a */
+/* pointer to a half-written record */
+/* ------------------------- */
+void RegionCache::store(glm::ivec2 pos, int lod, const Chunk::MeshInfo& info,
+    const std::vector<PackedVertex>& vertices, const std::vector<unsigned int>& indices)
+{
+    std::shared_ptr<RegionFile> file = region(regionOf(pos));
+    if (!file)
+        return;
+
+    // Header and checksum first, outside the lock; the arrays are written
+    // from the caller's vectors at the header's offsets, without a copy
+    MeshBlobHeader header = makeMeshBlobHeader(info, vertices.data(), vertices.size(), indices.data(), indices.size());
+    RegionIndexEntry entry = { 0, meshBlobBytes(header) };
+    int slot = slotOf(pos, lod);
+
+    std::lock_guard<std::mutex> lock(file->mutex);
+    entry.offset = file->end;
+
+    bool ok = file->write(entry.offset, &header, sizeof(header))
+        && file->write(entry.offset + header.vertexOffset, vertices.data(), vertices.size() * sizeof(PackedVertex))
+        && file->write(entry.offset + header.indexOffset, indices.data(), indices.size() * sizeof(unsigned int))
+        && file->write(REGION_INDEX_OFFSET + slot * sizeof(RegionIndexEntry), &entry, sizeof(entry));
+    if (!ok)
+        return;
+
+    file->index[slot] = entry;
+    file->end = alignUp(entry.offset + entry.bytes, REGION_RECORD_ALIGNMENT);
+
+    storeCount.fetch_add(1, std::memory_order_relaxed);
+    writtenBytes.fetch_add(entry.bytes, std::memory_order_relaxed);
+}
+
+RegionCache::Stats RegionCache::stats() const
+{
+    Stats s;
+    s.hits = hitCount.load(std::memory_order_relaxed);
+    s.misses = missCount.load(std::memory_order_relaxed);
+    s.stores = storeCount.load(std::memory_order_relaxed);
+    s.bytesWritten = writtenBytes.load(std::memory_order_relaxed);
+    s.staleRegions = staleCount.load(std::memory_order_relaxed);
+    s.corruptRecords = corruptCount.load(std::memory_order_relaxed);
+    return s;
+}
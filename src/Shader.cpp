@@ -91,4 +91,14 @@ void Shader::checkCompileErrors(GLuint shader, std::string type)
 void Shader::setVec3(const std::string& name, const glm::vec3& vec) const
 {
     glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &vec[0]);
+}
+
+void Shader::setFloat(const std::string& name, float value) const
+{
+    glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+}
+
+void Shader::setInt(const std::string& name, int value) const
+{
+    glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
 }
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "../include/UploadBudget.h"
+#include <algorithm>
+
+#define UPLOAD_COST_DECAY 0.98      // Weight kept by older samples per new upload
+#define MIN_FIT_SAMPLES 8.0         // Effective samples needed before trusting the fit
+
+/* -------------------------- */
+/* UploadBudget Constructor */
+/* -------------------------- */
+UploadBudget::UploadBudget(double budgetMicros)
+    : budgetMicros(budgetMicros)
+{
+}
+
+double UploadBudget::estimate(std::size_t bytes) const
+{
+    return fixedCost + perByteCost * double(bytes);
+}
+
+void UploadBudget::beginFrame()
+{
+    spentMicros = 0.0;
+    uploadsThisFrame = 0;
+}
+
+bool UploadBudget::canAfford(std::size_t bytes) const
+{
+    if (uploadsThisFrame == 0)
+        return true;
+
+    return spentMicros + estimate(bytes) <= budgetMicros;
+}
+
+/* -------------------------- */
+/* Charge one upload and fold it into the cost model */
+/* -------------------------- */
+void UploadBudget::record(std::size_t bytes, double micros)
+{
+    spentMicros += micros;
+    uploadsThisFrame++;
+    frameStats.uploads++;
+
+    double x = double(bytes);
+    sumW = sumW * UPLOAD_COST_DECAY + 1.0;
+    sumX = sumX * UPLOAD_COST_DECAY + x;
+    sumY = sumY * UPLOAD_COST_DECAY + micros;
+    sumXX = sumXX * UPLOAD_COST_DECAY + x * x;
+    sumXY = sumXY * UPLOAD_COST_DECAY + x * micros;
+
+    refit();
+}
+
+/* -------------------------- */
+/* Weighted least squares for fixed + perByte * bytes */
+/* Falls back to scaling the current slope when sizes are too uniform */
+/* -------------------------- */
+void UploadBudget::refit()
+{
+    if (sumW < MIN_FIT_SAMPLES)
+    {
+        // Too few samples for two terms: keep the slope, match the mean
+        double meanX = sumX / sumW;
+        double meanY = sumY / sumW;
+        fixedCost = std::max(0.0, meanY - perByteCost * meanX);
+        return;
+    }
+
+    double meanX = sumX / sumW;
+    double meanY = sumY / sumW;
+    double varX = sumXX / sumW - meanX * meanX;
+    double covXY = sumXY / sumW - meanX * meanY;
+
+    // Sizes vary by less than ~1 KB: the slope is not identifiable
+    if (varX < 1024.0 * 1024.0)
+    {
+        fixedCost = std::max(0.0, meanY - perByteCost * meanX);
+        return;
+    }
+
+    perByteCost = std::max(0.0, covXY / varX);
+    fixedCost = std::max(0.0, meanY - perByteCost * meanX);
+}
+
+bool UploadBudget::endFrame()
+{
+    if (uploadsThisFrame == 0)
+        return false;
+
+    frameStats.frames++;
+    frameStats.lastFrameMicros = spentMicros;
+
+    if (spentMicros <= budgetMicros)
+        return false;
+
+    frameStats.overrunFrames++;
+    frameStats.worstOverrunMicros = std::max(frameStats.worstOverrunMicros, spentMicros - budgetMicros);
+    return true;
+}
@@ -11,11 +11,10 @@ WaterMesh::WaterMesh(float yLevel, float size)
         {-half, yLevel,  half}
     };
 
-    std::vector<glm::vec3> norms(4, { 0, 1, 0 });
-    std::vector<glm::vec3> cols(4, { 0, 0, 1 }); // unused in shader
     std::vector<unsigned> idx = { 0, 1, 2, 0, 2, 3 };
 
-    mesh = new Mesh(verts, cols, norms, idx);
+    // water.vert only reads positions; normals come from the wave function
+    mesh = new Mesh(verts, idx);
 }
 
 void WaterMesh::draw(const Shader& shader)
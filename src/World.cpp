@@ -1,51 +1,114 @@
 #include "../include/World.h"
-#include <GLFW/glfw3.h>
+#include "../include/GlArenaBackend.h"
 #include <iostream>
-#include <glm/gtc/matrix_access.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+#define LOD_HYSTERESIS 1        // Chunks keep their LOD this far past a boundary
+#define HEIGHT_TILE_CACHE_SIZE 1024   // Tiles kept (~8 KB each); only LOD 0 chunks read them
+#define FINALIZE_BUDGET_US 2000.0     // GPU upload time allowed per frame (microseconds)
+#define FLAT_CULL_MAX_CHUNKS 4096     // Up to this many loaded chunks one SIMD pass beats the quadtree ("quadtree" bench)
+#define ARENA_INITIAL_VERTICES (1 << 20)  // 12 MB; ~800 chunks at ~1300 vertices each
+#define ARENA_INITIAL_INDICES (3 << 20)   // 12 MB; grows by doubling when full
+
+// Mesh hand-off counters, bumped from worker threads
+static std::atomic<std::uint64_t> payloadsAllocated{ 0 };
+static std::atomic<std::uint64_t> bytesHandedOff{ 0 };
+static std::atomic<std::uint64_t> bytesCopied{ 0 };
 
-#define LOAD_RADIUS 8
-#define UNLOAD_RADIUS 10
+/* ------------------------- */
+/* ChunkData: counted construction and copies */
+/* ------------------------- */
+ChunkData::ChunkData()
+{
+    payloadsAllocated.fetch_add(1, std::memory_order_relaxed);
+}
+
+ChunkData::ChunkData(const ChunkData& other)
+    : MpscNode(other), pos(other.pos), chunk(other.chunk),
+    vertices(other.vertices), indices(other.indices), cached(other.cached), hasMesh(other.hasMesh)
+{
+    payloadsAllocated.fetch_add(1, std::memory_order_relaxed);
+    bytesCopied.fetch_add(meshBytes(), std::memory_order_relaxed);
+}
+
+std::size_t ChunkData::meshBytes() const
+{
+    if (cached.valid())
+        return cached.bytes();
+    return vertices.size() * sizeof(PackedVertex) + indices.size() * sizeof(unsigned int);
+}
+
+MeshHandoffStats World::meshHandoffStats()
+{
+    MeshHandoffStats s;
+    s.payloadsAllocated = payloadsAllocated.load(std::memory_order_relaxed);
+    s.bytesHandedOff = bytesHandedOff.load(std::memory_order_relaxed);
+    s.bytesCopied = bytesCopied.load(std::memory_order_relaxed);
+    return s;
+}
 
 /* ------------------------- */
 /* World Constructor / Destructor */
 /* ------------------------- */
-World::World()
-    : lastUpdateTime(0.0f), running(true), lastCameraChunk(0)
+World::World(const WorldConfig& config)
+    : chunks(2 * std::max(config.unloadRadius, config.loadRadius) + 1), clock(config.clock),
+      chunkTree(float(CHUNK_SIZE * VOXEL_SIZE)), lastCameraChunk(0), lastUpdateTime(0.0),
+      ringDiff(config.ringDiffStreaming), loadRadius(config.loadRadius),
+      unloadRadius(std::max(config.unloadRadius, config.loadRadius)),
+      uploadBudget(FINALIZE_BUDGET_US), probeEnabled(config.latencyProbe)
 {
-    // Create shared biome manager
-    float voxelScale = float(VOXEL_SIZE) / DESIGN_VOXEL;
-    biomeMgr = new BiomeManager(voxelScale, WATER_LEVEL_WORLD);
+    std::copy(config.lodRadius, config.lodRadius + LOD_LEVELS - 1, lodRadius);
 
-    // Launch worker threads equal to hardware concurrency
-    const int numThreads = std::max(1u, std::thread::hardware_concurrency());
-    for (int i = 0; i < numThreads; ++i)
+    // Seconds since construction unless the caller supplies time
+    if (!clock)
     {
-        workers.emplace_back(&World::workerThread, this);
+        auto start = std::chrono::steady_clock::now();
+        clock = [start] { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); };
     }
 
+    // Create shared biome manager
+    float voxelScale = float(VOXEL_SIZE) / DESIGN_VOXEL;
+    biomeMgr = new BiomeManager(voxelScale, WATER_LEVEL_WORLD, config.seed);
+    heightTiles = new HeightTileCache(biomeMgr, HEIGHT_TILE_CACHE_SIZE);
+    regionCache = config.regionCacheDir.empty() ? nullptr
+        : new RegionCache(config.regionCacheDir, biomeMgr->generatorKey());
+
+    // One set of GPU buffers for every chunk mesh
+    ownsBackend = config.backend == nullptr;
+    arenaBackend = ownsBackend ? new GlArenaBackend() : config.backend;
+    meshArena = new MeshArena(arenaBackend, ARENA_INITIAL_VERTICES, ARENA_INITIAL_INDICES);
+
+    // Launch worker threads (hardware concurrency by default)
+    jobs = new JobSystem(config.workerThreads);
+
     // Initialize by updating at origin
     update(glm::vec3(0));
 }
 
 World::~World()
 {
-    // Signal workers to stop and join threads
-    {
-        std::lock_guard<std::mutex> lock(taskMutex);
-        running = false;
-    }
-    taskCondition.notify_all();
-
-    for (auto& worker : workers)
-    {
-        if (worker.joinable())
-            worker.join();
-    }
-
-    // Clean up all chunks
-    for (auto& entry : chunks)
-        delete entry.second;
+    // Stop workers; chunks still queued are never generated
+    delete jobs;
+
+    // Discard chunks finished but not yet finalized
+    for (std::unique_ptr<ChunkData>& data : readyChunks)
+        delete data->chunk;
+    while (std::unique_ptr<ChunkData> data = completedChunks.pop())
+        delete data->chunk;
+
+    // Clean up all chunks (their meshes go back to the arena)
+    for (const ChunkGrid::Entry& entry : chunks)
+        delete entry.chunk;
     chunks.clear();
+
+    delete meshArena;
+    if (ownsBackend)
+        delete arenaBackend;
+    delete regionCache;
+    delete heightTiles;
+    delete biomeMgr;   // Last: the caches above sample through it
 }
 
 /* ------------------------- */
@@ -53,10 +116,14 @@ World::~World()
 /* ------------------------- */
 void World::update(const glm::vec3& cameraPos)
 {
-    float currentTime = glfwGetTime();
+    double currentTime = clock();
+    probe.uploadLatency.clear();
 
-    // Limit update frequency to 5Hz (every 0.2s)
-    if (currentTime - lastUpdateTime < 0.2f)
+    // Upload finished chunks every frame, within the time budget
+    processCompletedChunks();
+
+    // Limit streaming updates to 5Hz (every 0.2s)
+    if (currentTime - lastUpdateTime < 0.2)
         return;
 
     lastUpdateTime = currentTime;
@@ -67,230 +134,542 @@ void World::update(const glm::vec3& cameraPos)
     // Queue new chunks or unload distant ones only if camera chunk changed or no chunks loaded
     if (cameraChunk != lastCameraChunk || chunks.empty())
     {
-        queueChunks(cameraChunk, cameraPos);
-        unloadChunks(cameraChunk);
+        // Until something is loaded, scan everything; afterwards only the
+        // strips of the windows that the move from lastCameraChunk changed
+        bool fullScan = !ringDiff || chunks.empty();
+        std::vector<JobSystem::PrioritizedJob> batch;
+        auto scanStart = std::chrono::steady_clock::now();
+        queueChunks(cameraChunk, fullScan, batch);
+        unloadChunks(cameraChunk, fullScan);
+        updateLods(cameraChunk, fullScan, batch);
+        scanSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - scanStart).count();
         lastCameraChunk = cameraChunk;
+
+        // One hand-off after the scans, so no worker competes with them
+        jobs->submitBatch(std::move(batch));  // Wakes every idle worker
     }
+}
 
-    // Process chunks completed by worker threads
-    processCompletedChunks();
+static int chunkDistance(const glm::ivec2& pos, const glm::ivec2& centerChunk)
+{
+    return std::max(std::abs(pos.x - centerChunk.x), std::abs(pos.y - centerChunk.y));
+}
+
+int World::chunkPriority(const glm::ivec2& pos, const glm::ivec2& centerChunk) const
+{
+    return std::min(chunkDistance(pos, centerChunk) * JobSystem::PRIORITY_LEVELS / (loadRadius + 1),
+        JobSystem::PRIORITY_LEVELS - 1);
+}
+
+int World::lodForDistance(int distance) const
+{
+    int lod = 0;
+    while (lod < LOD_LEVELS - 1 && distance > lodRadius[lod])
+        ++lod;
+    return lod;
+}
+
+// A chunk is kept until it is LOD_HYSTERESIS rings past either edge of
+// its band, so a camera wobbling across a boundary does not rebuild the
+// chunks along it
+bool World::lodAcceptable(int lod, int distance) const
+{
+    bool tooFar = lod < LOD_LEVELS - 1 && distance - LOD_HYSTERESIS > lodRadius[lod];
+    bool tooNear = lod > 0 && distance + LOD_HYSTERESIS <= lodRadius[lod - 1];
+    return !tooFar && !tooNear;
 }
 
 /* ------------------------- */
 /* Add nearby chunks to the task queue for generation */
+/* Cancels queued tasks that left the load radius (or whose loaded chunk */
+/* has become acceptable again) and re-scores the priority and LOD of the rest */
+/* (tasks only holds chunks in flight, so that pass is not per window) */
 /* ------------------------- */
-void World::queueChunks(const glm::ivec2& centerChunk, const glm::vec3& cameraPos)
+void World::queueChunks(const glm::ivec2& centerChunk, bool fullScan, std::vector<JobSystem::PrioritizedJob>& batch)
 {
     std::lock_guard<std::mutex> lock(taskMutex);
 
-    for (int x = -LOAD_RADIUS; x <= LOAD_RADIUS; ++x)
+    // Re-score or cancel tasks that have not started yet
+    for (auto it = tasks.begin(); it != tasks.end();)
     {
-        for (int z = -LOAD_RADIUS; z <= LOAD_RADIUS; ++z)
+        glm::ivec2 pos = it->first;
+        ChunkTask& task = it->second;
+        int distanceGrid = chunkDistance(pos, centerChunk);
+
+        if (task.state == ChunkTaskState::Queued)
         {
-            glm::ivec2 pos = centerChunk + glm::ivec2(x, z);
-            int distanceGrid = std::max(std::abs(x), std::abs(z));
-            if (distanceGrid > LOAD_RADIUS) continue;
+            Chunk* loaded = chunks.find(pos);
+            if (distanceGrid > loadRadius || (loaded && lodAcceptable(loaded->lod(), distanceGrid)))
+            {
+                // The pending job finds no entry and exits without generating
+                stats.cancelled++;
+                it = tasks.erase(it);
+                continue;
+            }
 
-            if (chunks.find(pos) == chunks.end())
+            // The job reads the level when it starts, so no re-submit for that
+            task.lod = lodForDistance(distanceGrid);
+
+            int priority = chunkPriority(pos, centerChunk);
+            if (priority != task.priority)
             {
-                // Calculate chunk center position in world space
-                glm::vec3 chunkCenter(
-                    pos.x * CHUNK_SIZE + CHUNK_SIZE / 2.0f,
-                    CHUNK_HEIGHT / 2.0f,
-                    pos.y * CHUNK_SIZE + CHUNK_SIZE / 2.0f);
-
-                float dist = glm::distance(cameraPos, chunkCenter);
-                taskQueue.push({ pos, dist });
+                // Re-submit under a new ticket; the old job becomes a no-op
+                task.priority = priority;
+                unsigned ticket = ++task.ticket;
+                batch.push_back({ [this, pos, ticket] { generateChunk(pos, ticket); }, priority });
+                stats.reprioritised++;
             }
         }
+        ++it;
+    }
+
+    // Everything in the old window is already loaded or in flight, so
+    // after a move only the entering strips can need new tasks
+    std::vector<glm::ivec2> candidates;
+    if (fullScan)
+    {
+        for (int x = -loadRadius; x <= loadRadius; ++x)
+            for (int z = -loadRadius; z <= loadRadius; ++z)
+                candidates.push_back(centerChunk + glm::ivec2(x, z));
+    }
+    else
+    {
+        ChunkGrid::windowDifference(centerChunk, lastCameraChunk, loadRadius, candidates);
+    }
+
+    for (const glm::ivec2& pos : candidates)
+    {
+        if (chunks.contains(pos))
+            continue;
+
+        if (tasks.find(pos) != tasks.end())
+        {
+            stats.duplicatesSkipped++;
+            continue;
+        }
+
+        int priority = chunkPriority(pos, centerChunk);
+        tasks[pos] = { ChunkTaskState::Queued, 0u, priority, lodForDistance(chunkDistance(pos, centerChunk)) };
+        batch.push_back({ [this, pos] { generateChunk(pos, 0u); }, priority });
+        if (probeEnabled)
+            pendingChunks[pos] = { lastUpdateTime, false };
     }
 
-    taskCondition.notify_one();  // Wake one worker thread
+    // Chunks that left the load window before being drawn are not waited for
+    for (auto it = pendingChunks.begin(); it != pendingChunks.end();)
+    {
+        if (chunkDistance(it->first, centerChunk) > loadRadius)
+            it = pendingChunks.erase(it);
+        else
+            ++it;
+    }
 }
 
 /* ------------------------- */
-/* Worker thread function: generates chunk mesh data */
+/* Job body: generates chunk mesh data on a worker thread */
 /* ------------------------- */
-void World::workerThread()
+void World::generateChunk(glm::ivec2 pos, unsigned ticket)
 {
-    while (true)
+    // Claim the task unless it was cancelled or re-queued
+    int lod;
     {
-        glm::ivec2 pos;
-
-        // Wait for task or shutdown signal
-        {
-            std::unique_lock<std::mutex> lock(taskMutex);
-            taskCondition.wait(lock, [this] { return !taskQueue.empty() || !running; });
+        std::lock_guard<std::mutex> lock(taskMutex);
+        auto it = tasks.find(pos);
+        if (it == tasks.end() || it->second.state != ChunkTaskState::Queued || it->second.ticket != ticket)
+            return;
 
-            if (!running && taskQueue.empty())
-                return;
+        it->second.state = ChunkTaskState::Generating;
+        lod = it->second.lod;
+    }
 
-            pos = taskQueue.top().pos;
-            taskQueue.pop();
-        }
+    // Load from the region cache, or generate chunk data straight into
+    // the hand-off payload and cache it (empty chunks too)
+    std::unique_ptr<ChunkData> data(new ChunkData());
+    data->pos = pos;
+    data->chunk = new Chunk(pos, biomeMgr, heightTiles, lod);
+    if (regionCache && regionCache->load(pos, lod, data->cached))
+    {
+        data->chunk->restoreMesh(data->cached.info());
+        data->hasMesh = data->cached.vertexCount() > 0;
+    }
+    else
+    {
+        data->hasMesh = data->chunk->generateData(data->vertices, data->indices);
+        if (regionCache)
+            regionCache->store(pos, lod, data->chunk->meshInfo(), data->vertices, data->indices);
+    }
 
-        // Create and generate chunk data
-        Chunk* chunk = new Chunk(pos, biomeMgr);
+    {
+        std::lock_guard<std::mutex> lock(taskMutex);
+        tasks[pos].state = ChunkTaskState::Done;
+        stats.generated++;
+    }
 
-        std::vector<glm::vec3> vertices, colors, normals;
-        std::vector<unsigned int> indices;
-        bool hasMesh = chunk->generateData(vertices, colors, normals, indices);
+    // Hand ownership to the main thread for finalization
+    bytesHandedOff.fetch_add(data->meshBytes(), std::memory_order_relaxed);
+    completedChunks.push(std::move(data));
+}
 
-        // Store completed chunk data for finalization in main thread
-        {
-            std::lock_guard<std::mutex> lock(completedMutex);
-            completedChunks.push({ pos, chunk, vertices, colors, normals, indices, hasMesh });
-        }
-    }
+StreamingStats World::streamingStats()
+{
+    std::lock_guard<std::mutex> lock(taskMutex);
+    return stats;
 }
 
 /* ------------------------- */
 /* Finalize and upload completed chunk mesh data */
+/* Everything the workers have finished is taken at once and finalized */
+/* nearest the camera first, so the budget goes to the chunks that fill */
+/* holes, and the result does not depend on the order workers finished */
 /* ------------------------- */
 void World::processCompletedChunks()
 {
-    std::queue<ChunkData> tempQueue;
+    uploadBudget.beginFrame();
+
+    while (std::unique_ptr<ChunkData> data = completedChunks.pop())
+        readyChunks.push_back(std::move(data));
 
-    // Move all completed chunks into temporary queue (thread safe)
+    const glm::ivec2 center = lastCameraChunk;
+    std::sort(readyChunks.begin(), readyChunks.end(),
+        [center](const std::unique_ptr<ChunkData>& a, const std::unique_ptr<ChunkData>& b)
+        {
+            int da = chunkDistance(a->pos, center), db = chunkDistance(b->pos, center);
+            if (da != db)
+                return da < db;
+            if (a->pos.x != b->pos.x)
+                return a->pos.x < b->pos.x;
+            if (a->pos.y != b->pos.y)
+                return a->pos.y < b->pos.y;
+            return a->chunk->lod() < b->chunk->lod();
+        });
+
+    // LOD rebuilds are submitted after the loop, once this frame's batch is settled
+    std::vector<JobSystem::PrioritizedJob> rebuilds;
+
+    // Finalize chunks until the next upload is predicted to exceed the budget
+    std::size_t next = 0;
+    for (; next < readyChunks.size(); ++next)
     {
-        std::lock_guard<std::mutex> lock(completedMutex);
-        tempQueue = std::move(completedChunks);
-        completedChunks = std::queue<ChunkData>();
-    }
+        std::unique_ptr<ChunkData> data = std::move(readyChunks[next]);
 
-    int finalizedThisFrame = 0;
+        int distance = chunkDistance(data->pos, lastCameraChunk);
+        bool outOfRange = distance > unloadRadius;
 
-    // Finalize up to maxFinalizePerFrame chunks this frame
-    while (!tempQueue.empty() && finalizedThisFrame < maxFinalizePerFrame)
-    {
-        ChunkData data = tempQueue.front();
-        tempQueue.pop();
+        // A loaded chunk at another LOD is replaced; at the same LOD this was built twice
+        Chunk* loaded = chunks.find(data->pos);
+        bool duplicate = loaded && loaded->lod() == data->chunk->lod();
 
-        if (chunks.find(data.pos) == chunks.end())
+        if (outOfRange || duplicate)
         {
-            if (data.hasMesh)
+            // Camera moved away (or the chunk was built twice): the work is lost
+            delete data->chunk;
+            std::lock_guard<std::mutex> lock(taskMutex);
+            stats.wasted++;
+            auto it = tasks.find(data->pos);
+            if (it != tasks.end() && it->second.state == ChunkTaskState::Done)
+                tasks.erase(it);
+            continue;
+        }
+
+        if (data->hasMesh)
+        {
+            std::size_t bytes = data->meshBytes();
+            if (!uploadBudget.canAfford(bytes))
             {
-                data.chunk->finalize(data.vertices, data.colors, data.normals, data.indices);
-                chunks[data.pos] = data.chunk;
-                finalizedThisFrame++;
+                readyChunks[next] = std::move(data);   // First in line next frame
+                break;
             }
+
+            double uploadStart = clock();
+            if (data->cached.valid())
+                data->chunk->finalize(meshArena, data->cached.vertices(), data->cached.vertexCount(),
+                    data->cached.indices(), data->cached.indexCount());
             else
+                data->chunk->finalize(meshArena, data->vertices, data->indices);
+            double uploadEnd = clock();
+            uploadBudget.record(bytes, (uploadEnd - uploadStart) * 1e6);
+
+            auto pending = pendingChunks.find(data->pos);
+            if (pending != pendingChunks.end() && !pending->second.uploaded)
+            {
+                probe.uploadLatency.push_back(uploadEnd - pending->second.entered);
+                pending->second.uploaded = true;
+            }
+
+            // The previous LOD stays drawn until its replacement is uploaded
+            if (loaded)
+            {
+                chunks.erase(data->pos);
+                removeBounds(loaded);
+                delete loaded;
+            }
+
+            addBounds(data->chunk);
+
+            MeshHandle mesh = data->chunk->mesh();
+            if (meshChunks.size() <= mesh)
+                meshChunks.resize(mesh + 1, nullptr);
+            meshChunks[mesh] = data->chunk;
+
+            // The slot may still hold a chunk that left the window before the last unload
+            if (Chunk* stale = chunks.insert(data->pos, data->chunk))
             {
-                delete data.chunk;  // Discard empty chunk
+                removeBounds(stale);
+                delete stale;
+            }
+
+            // chunks now de-duplicates this position; any re-queued job becomes a no-op
+            std::lock_guard<std::mutex> lock(taskMutex);
+            tasks.erase(data->pos);
+
+            // The camera may have crossed a LOD band while this was being built
+            if (!lodAcceptable(data->chunk->lod(), distance))
+            {
+                glm::ivec2 pos = data->pos;
+                int priority = chunkPriority(pos, lastCameraChunk);
+                tasks[pos] = { ChunkTaskState::Queued, 0u, priority, lodForDistance(distance) };
+                rebuilds.push_back({ [this, pos] { generateChunk(pos, 0u); }, priority });
             }
         }
         else
         {
-            delete data.chunk;  // Chunk already exists, discard duplicate
-        }
-    }
+            delete data->chunk;  // Discard empty chunk
+            pendingChunks.erase(data->pos);
+            if (loaded)
+            {
+                // Empty at this LOD; drop the other level's mesh too
+                chunks.erase(data->pos);
+                removeBounds(loaded);
+                delete loaded;
+            }
 
-    // Return remaining chunks to completed queue for next frame
-    if (!tempQueue.empty())
-    {
-        std::lock_guard<std::mutex> lock(completedMutex);
-        while (!tempQueue.empty())
-        {
-            completedChunks.push(tempQueue.front());
-            tempQueue.pop();
+            // Keep it marked Done so it is not regenerated until it leaves the unload radius
+            std::lock_guard<std::mutex> lock(taskMutex);
+            tasks[data->pos] = { ChunkTaskState::Done, 0u, 0, 0 };
         }
     }
+
+    readyChunks.erase(readyChunks.begin(), readyChunks.begin() + next);
+    uploadBudget.endFrame();
+    jobs->submitBatch(std::move(rebuilds));
+}
+
+/* ------------------------- */
+/* Culling bounds of a loaded chunk: its full cell and mesh height in */
+/* the quadtree, its tight mesh box in the flat culler */
+/* ------------------------- */
+void World::addBounds(const Chunk* chunk)
+{
+    glm::vec3 boundsMin, boundsMax;
+    chunk->bounds(boundsMin, boundsMax);
+    chunkTree.insert(chunk->position, chunk->mesh(), boundsMin.y, boundsMax.y);
+    culler.set(chunk->mesh(), boundsMin, boundsMax);
+}
+
+void World::removeBounds(const Chunk* chunk)
+{
+    chunkTree.remove(chunk->position);
+    culler.remove(chunk->mesh());
 }
 
 /* ------------------------- */
 /* Unload chunks far from camera to free memory */
 /* ------------------------- */
-void World::unloadChunks(const glm::ivec2& centerChunk)
+void World::unloadChunks(const glm::ivec2& centerChunk, bool fullScan)
 {
+    // Every loaded chunk is within unloadRadius of lastCameraChunk, so
+    // after a move only the strips leaving that window can hold chunks to drop
     std::vector<glm::ivec2> toRemove;
+    if (fullScan)
+        chunkTree.collectOutside(centerChunk, unloadRadius, toRemove);
+    else
+        ChunkGrid::windowDifference(lastCameraChunk, centerChunk, unloadRadius, toRemove);
 
-    // Find chunks beyond unload radius
-    for (const auto& entry : chunks)
+    // Delete and remove those chunks
+    for (const auto& pos : toRemove)
     {
-        glm::ivec2 pos = entry.first;
-        int distance = std::max(std::abs(pos.x - centerChunk.x), std::abs(pos.y - centerChunk.y));
-        if (distance > UNLOAD_RADIUS)
-            toRemove.push_back(pos);
+        if (Chunk* chunk = chunks.erase(pos))
+        {
+            removeBounds(chunk);
+            delete chunk;
+        }
     }
 
-    // Delete and remove those chunks
-    for (const auto& pos : toRemove)
+    // Forget empty chunks that are out of range so they can be rebuilt later
+    // (Done tasks are kept only within the unload window too)
+    std::lock_guard<std::mutex> lock(taskMutex);
+    if (!fullScan)
     {
-        delete chunks[pos];
-        chunks.erase(pos);
+        for (const auto& pos : toRemove)
+        {
+            auto it = tasks.find(pos);
+            if (it != tasks.end() && it->second.state == ChunkTaskState::Done)
+                tasks.erase(it);
+        }
+        return;
+    }
+
+    for (auto it = tasks.begin(); it != tasks.end();)
+    {
+        glm::ivec2 pos = it->first;
+        int distance = std::max(std::abs(pos.x - centerChunk.x), std::abs(pos.y - centerChunk.y));
+        if (it->second.state == ChunkTaskState::Done && distance > unloadRadius)
+            it = tasks.erase(it);
+        else
+            ++it;
     }
 }
 
 /* ------------------------- */
-/* Check if a chunk is within the camera's view frustum */
+/* Re-level loaded chunks after a camera move */
+/* Every loaded chunk is acceptable at lastCameraChunk or already has a */
+/* task, and a move of m rings changes distances by at most m. So a chunk */
+/* can only have left its band in the m rings just inside each boundary */
+/* (less the hysteresis) or the m rings just outside it */
 /* ------------------------- */
-bool World::isChunkInFrustum(const glm::ivec2& pos, const glm::mat4& viewProj)
+void World::updateLods(const glm::ivec2& centerChunk, bool fullScan, std::vector<JobSystem::PrioritizedJob>& batch)
 {
-    const float SHRINK = 1.0f;  // <1 means tighter culling, 1.0 means normal
-
-    // Define chunk bounding box in world space
-    glm::vec3 minCorner(pos.x * CHUNK_SIZE * VOXEL_SIZE, 0.0f,
-        pos.y * CHUNK_SIZE * VOXEL_SIZE);
-    glm::vec3 maxCorner = minCorner + glm::vec3(CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE) * float(VOXEL_SIZE);
-
-    glm::vec3 center = (minCorner + maxCorner) * 0.5f;
-    glm::vec3 extents = (maxCorner - minCorner) * 0.5f;
-
-    // Extract frustum planes from view-projection matrix
-    glm::vec4 planes[6];
-    planes[0] = glm::row(viewProj, 3) + glm::row(viewProj, 0); // Left
-    planes[1] = glm::row(viewProj, 3) - glm::row(viewProj, 0); // Right
-    planes[2] = glm::row(viewProj, 3) + glm::row(viewProj, 1); // Bottom
-    planes[3] = glm::row(viewProj, 3) - glm::row(viewProj, 1); // Top
-    planes[4] = glm::row(viewProj, 3) + glm::row(viewProj, 2); // Near
-    planes[5] = glm::row(viewProj, 3) - glm::row(viewProj, 2); // Far
-
-    // Normalize planes
-    for (int i = 0; i < 6; ++i)
+    std::vector<glm::ivec2> candidates;
+    if (fullScan)
     {
-        float length = glm::length(glm::vec3(planes[i]));
-        if (length > 0.0001f)
-            planes[i] /= length;
+        for (const ChunkGrid::Entry& entry : chunks)
+            candidates.push_back(entry.pos);
     }
+    else
+    {
+        int moved = chunkDistance(centerChunk, lastCameraChunk);
+        for (int lod = 0; lod < LOD_LEVELS - 1; ++lod)
+        {
+            int nearFirst = std::max(lodRadius[lod] - LOD_HYSTERESIS - moved + 1, 0);
+            for (int r = nearFirst; r <= lodRadius[lod] - LOD_HYSTERESIS; ++r)
+                ChunkGrid::ring(centerChunk, r, candidates);
 
-    // Test each plane against the chunk's bounding box
-    for (int i = 0; i < 6; ++i)
+            int farLast = std::min(lodRadius[lod] + LOD_HYSTERESIS + moved, unloadRadius);
+            for (int r = lodRadius[lod] + LOD_HYSTERESIS + 1; r <= farLast; ++r)
+                ChunkGrid::ring(centerChunk, r, candidates);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(taskMutex);
+    for (const glm::ivec2& pos : candidates)
     {
-        glm::vec3 n = glm::vec3(planes[i]);
-        float d = planes[i].w;
+        Chunk* chunk = chunks.find(pos);
+        int distance = chunkDistance(pos, centerChunk);
+        if (!chunk || distance > loadRadius || lodAcceptable(chunk->lod(), distance))
+            continue;
+
+        // Queued tasks were re-scored by queueChunks; overlapping rings land here too
+        if (tasks.find(pos) != tasks.end())
+            continue;
+
+        // The loaded level keeps drawing until the rebuild replaces it
+        int priority = chunkPriority(pos, centerChunk);
+        tasks[pos] = { ChunkTaskState::Queued, 0u, priority, lodForDistance(distance) };
+        batch.push_back({ [this, pos] { generateChunk(pos, 0u); }, priority });
+    }
+}
 
-        // Projected radius of the box onto plane normal, scaled by SHRINK
-        float r = (extents.x * std::abs(n.x) +
-            extents.y * std::abs(n.y) +
-            extents.z * std::abs(n.z)) * SHRINK;
+/* ------------------------- */
+/* Collect draw commands for the visible chunk meshes */
+/* A chunk draws its transition strip on each face whose neighbour is one */
+/* LOD finer; ranges that sit back to back in the index buffer are merged */
+/* ------------------------- */
+void World::buildDrawCommands(const glm::mat4& viewProj, DrawCommandList& list)
+{
+    list.clear();
+
+    // Planes once per frame. A small window is one SIMD pass over every
+    // mesh box; a large one is cheaper to walk as a tree that rejects or
+    // accepts whole groups of chunks
+    Frustum frustum(viewProj);
+    if (chunkTree.size() <= FLAT_CULL_MAX_CHUNKS)
+        culler.cull(frustum, visibleMeshes);
+    else
+        chunkTree.cull(frustum, visibleMeshes);
+
+    for (std::uint32_t mesh : visibleMeshes)
+    {
+        MeshArena::DrawRange range = meshArena->range(mesh);
+        const Chunk* chunk = meshChunks[mesh];
 
-        // Signed distance from box center to plane
-        float s = glm::dot(n, center) + d;
+        Chunk::IndexRange pending = chunk->regularIndices();
+        for (int face = 0; face < Chunk::FACE_COUNT && chunk->lod() > 0; ++face)
+        {
+            Chunk* neighbour = chunks.find(chunk->position + Chunk::faceDirection(face));
+            Chunk::IndexRange strip = chunk->transitionIndices(face);
+            if (!neighbour || neighbour->lod() >= chunk->lod() || strip.count == 0)
+                continue;
 
-        // If completely outside this plane, cull
-        if (s + r < 0.0f)
-            return false;
+            if (strip.first == pending.first + pending.count)
+            {
+                pending.count += strip.count;
+                continue;
+            }
+            list.add(pending.count, range.firstIndex + pending.first, range.baseVertex);
+            pending = strip;
+        }
+        list.add(pending.count, range.firstIndex + pending.first, range.baseVertex);
     }
-
-    return true; // Intersects or is inside the frustum
+    list.addCulled(chunkTree.size() - visibleMeshes.size());
 }
 
 /* ------------------------- */
-/* Render all visible chunks */
+/* Render all visible chunks with a single multi-draw */
 /* ------------------------- */
 void World::draw(const Shader& shader, const glm::vec3& cameraPos, const glm::mat4& view, const glm::mat4& projection)
 {
-    glm::mat4 viewProj = projection * view;
+    shader.setInt("chunkOrigins", GlArenaBackend::PAGE_TABLE_TEXTURE_UNIT);
+    submitDraws(projection * view);
+}
+
+void World::submitDraws(const glm::mat4& viewProj)
+{
+    buildDrawCommands(viewProj, drawList);
+    if (probeEnabled)
+        probeFrame(Frustum(viewProj));
+
+    // Every chunk mesh lives in the arena's buffers: bind them once
+    meshArena->bind();
+    meshArena->submit(drawList);
 
-    for (auto& entry : chunks)
+    arenaBackend->bindVertexArray(0);
+}
+
+/* ------------------------- */
+/* Latency probe for one frame: chunks drawn for the first time leave */
+/* pendingChunks with their latency; pending chunks not uploaded yet */
+/* whose column (the full chunk height) is in view are holes */
+/* ------------------------- */
+void World::probeFrame(const Frustum& frustum)
+{
+    probe.drawLatency.clear();
+    probe.holes = 0;
+    if (pendingChunks.empty())
+        return;
+
+    double now = clock();
+    for (std::uint32_t mesh : visibleMeshes)
     {
-        if (isChunkInFrustum(entry.first, viewProj))
-        {
-            entry.second->draw(shader);
-        }
-        else
-        {
-            // Could add optional chunk LOD or skip rendering silently
-        }
+        auto pending = pendingChunks.find(meshChunks[mesh]->position);
+        if (pending == pendingChunks.end())
+            continue;
+        probe.drawLatency.push_back(now - pending->second.entered);
+        pendingChunks.erase(pending);
+    }
+
+    const float chunkWorld = float(CHUNK_SIZE * VOXEL_SIZE);
+    for (const auto& entry : pendingChunks)
+    {
+        if (entry.second.uploaded)
+            continue;
+        glm::vec3 minCorner(entry.first.x * chunkWorld, 0.0f, entry.first.y * chunkWorld);
+        glm::vec3 maxCorner = minCorner + glm::vec3(chunkWorld, float(CHUNK_HEIGHT * VOXEL_SIZE), chunkWorld);
+        if (frustum.intersects(minCorner, maxCorner))
+            probe.holes++;
     }
+}
+
+void World::waitForWorkers()
+{
+    jobs->waitIdle();
 }
\ No newline at end of file
@@ -4,10 +4,12 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <vector>
 #include <iostream>
+#include <cstring>
 
 #include "../include/Shader.h"
 #include "../include/Camera.h"
 #include "../include/World.h"
+#include "../include/CameraPath.h"
 
 // Camera setup and global variables for mouse input handling
 Camera camera(glm::vec3(40.0f, 300.0f, 40.0f));
@@ -79,11 +81,68 @@ void scroll_callback(GLFWwindow* window, double /*xoffset*/, double yoffset)
     camera.ProcessMouseScroll(yoffset);
 }
 
+/* ------------------------- */
+/* Streaming, upload and draw counters, printed with the FPS under --stats */
+/* ------------------------- */
+void printStats(World& world)
+{
+    const HeightTileCache& tiles = world.tileCache();
+    std::cout << "  height tiles: " << tiles.size() << " cached, "
+        << tiles.hits() << " hits / " << tiles.misses() << " misses\n";
+    StreamingStats streaming = world.streamingStats();
+    std::cout << "  chunks: " << streaming.generated << " generated, "
+        << streaming.wasted << " wasted, " << streaming.cancelled << " cancelled, "
+        << streaming.duplicatesSkipped << " duplicates skipped, "
+        << streaming.reprioritised << " reprioritised\n";
+    MeshHandoffStats handoff = World::meshHandoffStats();
+    std::cout << "  mesh hand-off: " << handoff.payloadsAllocated << " payloads, "
+        << handoff.bytesHandedOff / 1024 << " KB moved, "
+        << handoff.bytesCopied << " bytes copied\n";
+    const UploadBudget& budget = world.finalizeBudget();
+    std::cout << "  uploads: " << budget.stats().uploads << " meshes, "
+        << budget.stats().overrunFrames << " frames over " << budget.budget() << " us budget (worst +"
+        << budget.stats().worstOverrunMicros << " us), model " << budget.fixedMicros() << " us + "
+        << budget.microsPerKB() << " us/KB\n";
+    MeshArena::Stats arena = world.meshArenaStats();
+    std::cout << "  mesh arena: " << arena.liveMeshes << " meshes, vertices "
+        << arena.vertexUsed << "/" << arena.vertexCapacity << " (frag " << arena.vertexFragmentation
+        << "), indices " << arena.indexUsed << "/" << arena.indexCapacity << " (frag " << arena.indexFragmentation
+        << "), " << arena.grows << " grows, " << arena.defragments << " compactions\n";
+    RegionCache::Stats regions = world.regionCacheStats();
+    std::cout << "  region cache: " << regions.hits << " hits, " << regions.misses << " misses, "
+        << regions.stores << " stored (" << regions.bytesWritten / 1024 << " KB), "
+        << regions.staleRegions << " stale regions reset, " << regions.corruptRecords << " corrupt records\n";
+    const DrawCommandList& draws = world.lastDrawList();
+    std::cout << "  draws: " << draws.drawCount() << " ranges (chunks + LOD seams) in 1 multi-draw, "
+        << draws.culledCount() << " culled, " << draws.triangleCount() << " triangles\n";
+}
+
 /* ------------------------- */
 /* Main entry point */
+/* Usage: ProceduralTerrain [--record-path FILE] [--stats] */
+/* --record-path saves the camera at CAMERA_PATH_TICK_HZ to FILE on exit, */
+/* for TerrainBench replay --path=FILE */
+/* --stats prints the world's counters under the once-a-second FPS line */
 /* ------------------------- */
-int main()
+int main(int argc, char** argv)
 {
+    const char* recordFile = nullptr;
+    bool printWorldStats = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--record-path") == 0 && i + 1 < argc)
+            recordFile = argv[++i];
+        else if (std::strcmp(argv[i], "--stats") == 0)
+            printWorldStats = true;
+        else
+        {
+            std::cerr << "Usage: ProceduralTerrain [--record-path FILE] [--stats]\n";
+            return 1;
+        }
+    }
+    CameraPath recording;
+    float recordTimer = 0.0f;
+
     // Initialize GLFW
     glfwInit();
 
@@ -149,6 +208,8 @@ int main()
         if (fpsTimer >= 1.0f)
         {
             std::cout << "FPS: " << frameCount / fpsTimer << "\n";
+            if (printWorldStats)
+                printStats(world);
             frameCount = 0;
             fpsTimer = 0.0f;
         }
@@ -157,6 +218,14 @@ int main()
         world.update(camera.Position);
         processInput(window, world);
 
+        // One key per elapsed tick, so the replay runs at a fixed rate whatever the frame rate was
+        if (recordFile)
+        {
+            recordTimer += deltaTime;
+            for (; recordTimer >= recording.tickSeconds(); recordTimer -= float(recording.tickSeconds()))
+                recording.add({ camera.Position, camera.Yaw, camera.Pitch });
+        }
+
         // Clear screen with sky color and depth buffer
         glClearColor(0.53f, 0.81f, 0.92f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -174,6 +243,7 @@ int main()
 
         shader.setVec3("lightDir", glm::normalize(glm::vec3(-0.7f, -0.7f, -0.7f)));
         shader.setVec3("viewPos", camera.Position);
+        shader.setFloat("positionScale", 1.0f / POSITION_STEPS_PER_UNIT);
 
         // Draw world chunks visible to the camera
         world.draw(shader, camera.Position, view, projection);
@@ -183,6 +253,14 @@ int main()
         glfwPollEvents();
     }
 
+    if (recordFile)
+    {
+        if (recording.save(recordFile))
+            std::cout << "Recorded " << recording.size() << " camera ticks to " << recordFile << "\n";
+        else
+            std::cerr << "Failed to write camera path " << recordFile << "\n";
+    }
+
     // Clean up and exit
     glfwTerminate();
     return 0;